@@ -44,6 +44,7 @@
 #include "suite/BEDOPS.Constants.hpp"
 #include "suite/BEDOPS.Version.hpp"
 #include "utility/Exception.hpp"
+#include "utility/PrintTypes.hpp"
 
 namespace {
 
@@ -289,7 +290,7 @@ namespace {
         bt->end(bt->start()+1);
 
         if ( first ) {
-          printf("%s\n", bt->chrom());
+          PrintTypes::Println(bt->chrom());
           first = !first;
         }
 
@@ -302,7 +303,7 @@ namespace {
           std::fseek(f, lbound.second, SEEK_SET);
           ByteOffset b = std::ftell(f);
           auto q = new QueryBedType(f);
-          printf("%s\n", q->chrom());
+          PrintTypes::Println(q->chrom());
           delete q;
           std::fseek(f, b, SEEK_SET);
         }
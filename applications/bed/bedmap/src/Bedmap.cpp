@@ -21,19 +21,27 @@
 //    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 //
 
+#include <signal.h>
 #include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstdio>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "algorithm/bed/ListChromosomes.hpp"
 #include "algorithm/visitors/BedVisitors.hpp"
 #include "algorithm/visitors/helpers/NamedVisitors.hpp"
 #include "algorithm/visitors/helpers/ProcessVisitorRow.hpp"
@@ -47,8 +55,11 @@
 #include "suite/BEDOPS.Version.hpp"
 #include "utility/Assertion.hpp"
 #include "utility/ByLine.hpp"
+#include "utility/ConcurrentPooledMemory.hpp"
 #include "utility/Exception.hpp"
 #include "utility/FPWrap.hpp"
+#include "utility/OutputBuffer.hpp"
+#include "utility/PooledMemory.hpp"
 #include "utility/Typify.hpp"
 
 #include "Input.hpp"
@@ -62,6 +73,14 @@ namespace BedMap {
   const std::string citation = BEDOPS::citation();
   constexpr std::size_t PoolSz = 8*8*8;
   bool minimumMemory = false;
+  int ioThreads = 0; // inputs read ahead on threads of their own
+
+  // the pooled iterators' records: one thread builds and releases them, unless
+  //  --io-threads builds them on a reader and the sweep releases them
+  template <typename BedType>
+  using PoolType = Ext::PooledMemory<BedType, PoolSz>;
+  template <typename BedType>
+  using ConcurrentPoolType = Ext::ConcurrentPooledMemory<BedType, PoolSz>;
 
   //======
   // Help
@@ -95,6 +114,12 @@ namespace BedMap {
 
   bool checkStarchNesting(const std::string&, const std::string&);
 
+  template <typename InputType>
+  void runMapping(const InputType& input, const std::string& chrom);
+
+  template <typename InputType>
+  void runParallel(const InputType& input);
+
 } // namespace BedMap
 
 
@@ -110,69 +135,10 @@ int main(int argc, char **argv) {
   try {
     InputType input(argc, argv);
 
-    std::vector<std::string> visitorNames = input.visitorNames_;
-    std::vector< std::vector<std::string> > visitorArgs = input.visitorArgs_;
-    const int prec = input.precision_;
-    const bool sci = input.useScientific_;
-    BedMap::minimumMemory = input.useMinMemory_;
-
-    // if all Starch inputs and no nested elements, then can use --faster if the
-    //   overlap criterion allows it.
-    const bool starchFast = !BedMap::checkStarchNesting(input.refFileName_, input.mapFileName_);
-    const bool nestCheck = input.errorCheck_ && input.fastMode_;
-
-    if ( input.isPercMap_ ) { // % overlap relative to MapType's size (signalmapish)
-      Bed::PercentOverlapMapping bedDist(input.percOvr_);
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else if ( input.isPercRef_ ) { // % overlap relative to RefTypes's size (setops -e)
-      Bed::PercentOverlapReference bedDist(input.percOvr_);
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else if ( input.isPercBoth_ ) { // % overlap relative to both MapType's and RefType's sizes
-      Bed::PercentOverlapBoth bedDist(input.percOvr_);
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else if ( input.isExact_ ) { // must be identical coordinates; should work fine with fully-nested elements
-      Bed::Exact bedDist;
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      const bool fastMode = true;
-      const bool noNestCheck = false; // safe with fully-nested elements
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, noNestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, fastMode,
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else if ( input.isPercEither_ ) { // % overlap relative to either MapType's or RefType's size
-      Bed::PercentOverlapEither bedDist(input.percOvr_);
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else if ( input.isRangeBP_ ) { // buffer each reference element
-      Bed::RangedDist bedDist(input.rangeBP_);
-      Bed::RangedDist sweepDist(input.rangeBP_); // same as bedDist in this case
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, (input.fastMode_ || starchFast),
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    } else { // require a certain amount of bp overlap
-      Bed::Overlapping bedDist(input.overlapBP_);
-      Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
-      BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
-                          input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
-                          input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, (input.fastMode_ || starchFast),
-                          input.sweepAll_, input.chrom_, input.skipUnmappedRows_, visitorNames, visitorArgs);
-    }
+    if ( input.threads_ > 1 )
+      BedMap::runParallel(input);
+    else
+      BedMap::runMapping(input, input.chrom_);
 
     return EXIT_SUCCESS;
   } catch(const BedMap::Help& h) { // show usage and exit success
@@ -212,13 +178,60 @@ namespace BedMap {
   //=============
   // get_pool()
   //============
-  template <typename BedTypePtr>
-  Ext::PooledMemory<typename std::remove_pointer<BedTypePtr>::type, PoolSz>&
+  template <typename BedTypePtr, template <typename> class Pool = PoolType>
+  Pool<typename std::remove_pointer<BedTypePtr>::type>&
   get_pool() {
-    static Ext::PooledMemory<typename std::remove_pointer<BedTypePtr>::type, PoolSz> pool;
+    static Pool<typename std::remove_pointer<BedTypePtr>::type> pool;
     return pool;
   }
 
+  //============
+  // pooledSweep(): pooled BED/Starch iterators, single-file mode
+  //============
+  template <template <typename> class Pool, typename RefType, typename SweepDistType, typename BedDistType, typename MVType>
+  void pooledSweep(const SweepDistType& st,
+                   const BedDistType& dt,
+                   Ext::FPWrap<Ext::InvalidFile>& refFile,
+                   bool fastMode,
+                   const std::string& chrom,
+                   MVType& multiv) {
+
+    auto& mem1 = get_pool<RefType*, Pool>();
+    Bed::allocate_iterator_starch_bed<RefType*, PoolSz, Pool<RefType>> refFileI(refFile, mem1, chrom, ioThreads > 0), refFileEnd;
+
+    // Do work
+    if ( !fastMode )
+      WindowSweep::sweep(refFileI, refFileEnd, st, multiv);
+    else // no nested elements
+      WindowSweep::sweep(refFileI, refFileEnd, dt, multiv);
+  }
+
+  //============
+  // pooledSweep(): pooled BED/Starch iterators, multi-file mode
+  //============
+  template <template <typename> class Pool, typename RefType, typename MapType, typename SweepDistType, typename BedDistType, typename MVType>
+  void pooledSweep(const SweepDistType& st,
+                   const BedDistType& dt,
+                   Ext::FPWrap<Ext::InvalidFile>& refFile,
+                   const std::string& mapFileName,
+                   bool fastMode,
+                   bool sweepAll,
+                   const std::string& chrom,
+                   MVType& multiv) {
+
+    auto& mem1 = get_pool<RefType*, Pool>();
+    Bed::allocate_iterator_starch_bed<RefType*, PoolSz, Pool<RefType>> refFileI(refFile, mem1, chrom, ioThreads > 0), refFileEnd;
+    Ext::FPWrap<Ext::InvalidFile> mapFile(mapFileName);
+    auto& mem2 = get_pool<MapType*, Pool>();
+    Bed::allocate_iterator_starch_bed<MapType*, PoolSz, Pool<MapType>> mapFileI(mapFile, mem2, chrom, ioThreads > 1), mapFileEnd;
+
+    // Do work
+    if ( !fastMode )
+      WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, st, multiv, sweepAll);
+    else // no nested elements
+      WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, dt, multiv, sweepAll);
+  }
+
   //============
   // runSweep(): single-file mode
   //============
@@ -247,14 +260,10 @@ namespace BedMap {
       // Create file handle iterators
       Ext::FPWrap<Ext::InvalidFile> refFile(refFileName);
       if ( !minimumMemory ) {
-        auto& mem1 = get_pool<RefType*>();
-        Bed::allocate_iterator_starch_bed<RefType*, PoolSz> refFileI(refFile, mem1, chrom), refFileEnd;
-
-        // Do work
-        if ( !fastMode )
-          WindowSweep::sweep(refFileI, refFileEnd, st, multiv);
-        else // no nested elements
-          WindowSweep::sweep(refFileI, refFileEnd, dt, multiv);
+        if ( ioThreads > 0 ) // records cross threads
+          pooledSweep<ConcurrentPoolType, RefType>(st, dt, refFile, fastMode, chrom, multiv);
+        else
+          pooledSweep<PoolType, RefType>(st, dt, refFile, fastMode, chrom, multiv);
       } else { // old school minimal memory iterator
         Bed::allocate_iterator_starch_bed_mm<RefType*> refFileI(refFile, chrom), refFileEnd;
 
@@ -273,8 +282,8 @@ namespace BedMap {
       if ( isStdin ) {
         if ( !minimumMemory ) {
           auto& mem1 = get_pool<RefType*>();
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileI(std::cin, refFileName, mem1, chrom, nestCheck);
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileEnd;
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileI(std::cin, refFileName, mem1, chrom, nestCheck);
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileEnd;
           if ( !fastMode )
             WindowSweep::sweep(refFileI, refFileEnd, st, multiv);
           else // no nested elements
@@ -290,8 +299,8 @@ namespace BedMap {
       } else {
         if ( !minimumMemory ) {
           auto& mem1 = get_pool<RefType*>();
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileI(infile, refFileName, mem1, chrom, nestCheck);
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileEnd;
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileI(infile, refFileName, mem1, chrom, nestCheck);
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileEnd;
           if ( !fastMode )
             WindowSweep::sweep(refFileI, refFileEnd, st, multiv);
           else // no nested elements
@@ -341,17 +350,10 @@ namespace BedMap {
       // Create file handle iterators
       Ext::FPWrap<Ext::InvalidFile> refFile(refFileName);
       if ( !minimumMemory ) {
-        auto& mem1 = get_pool<RefType*>();
-        Bed::allocate_iterator_starch_bed<RefType*, PoolSz> refFileI(refFile, mem1, chrom), refFileEnd;
-        Ext::FPWrap<Ext::InvalidFile> mapFile(mapFileName);
-        auto& mem2 = get_pool<MapType*>();
-        Bed::allocate_iterator_starch_bed<MapType*, PoolSz> mapFileI(mapFile, mem2, chrom), mapFileEnd;
-
-        // Do work
-        if ( !fastMode )
-          WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, st, multiv, sweepAll);
-        else // no nested elements
-          WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, dt, multiv, sweepAll);
+        if ( ioThreads > 0 ) // records cross threads
+          pooledSweep<ConcurrentPoolType, RefType, MapType>(st, dt, refFile, mapFileName, fastMode, sweepAll, chrom, multiv);
+        else
+          pooledSweep<PoolType, RefType, MapType>(st, dt, refFile, mapFileName, fastMode, sweepAll, chrom, multiv);
       } else { // old school minimal memory iterator
         Bed::allocate_iterator_starch_bed_mm<RefType*> refFileI(refFile, chrom), refFileEnd;
         Ext::FPWrap<Ext::InvalidFile> mapFile(mapFileName);
@@ -381,22 +383,22 @@ namespace BedMap {
         auto& mem1 = get_pool<RefType*>();
         auto& mem2 = get_pool<MapType*>();
         if ( isStdinRef ) {
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileI(std::cin, refFileName, mem1, chrom, nestCheck), refFileEnd;
-          Bed::bed_check_iterator<MapType*, PoolSz> mapFileI(mfin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileI(std::cin, refFileName, mem1, chrom, nestCheck), refFileEnd;
+          Bed::bed_check_iterator<MapType*, PoolSz, PoolType<MapType>> mapFileI(mfin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
           if ( !fastMode )
             WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, st, multiv, sweepAll);
           else // no nested elements
             WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, dt, multiv, sweepAll);
         } else {
-          Bed::bed_check_iterator<RefType*, PoolSz> refFileI(rfin, refFileName, mem1, chrom, nestCheck), refFileEnd;
+          Bed::bed_check_iterator<RefType*, PoolSz, PoolType<RefType>> refFileI(rfin, refFileName, mem1, chrom, nestCheck), refFileEnd;
           if ( isStdinMap ) {
-            Bed::bed_check_iterator<MapType*, PoolSz> mapFileI(std::cin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
+            Bed::bed_check_iterator<MapType*, PoolSz, PoolType<MapType>> mapFileI(std::cin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
             if ( !fastMode )
               WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, st, multiv, sweepAll);
             else // no nested elements
               WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, dt, multiv, sweepAll);
           } else {
-            Bed::bed_check_iterator<MapType*, PoolSz> mapFileI(mfin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
+            Bed::bed_check_iterator<MapType*, PoolSz, PoolType<MapType>> mapFileI(mfin, mapFileName, mem2, chrom, nestCheck), mapFileEnd;
             if ( !fastMode )
               WindowSweep::sweep(refFileI, refFileEnd, mapFileI, mapFileEnd, st, multiv, sweepAll);
             else // no nested elements
@@ -567,6 +569,7 @@ namespace BedMap {
            : GenerateVisitors<BaseVisitor, 4> {
 
     typedef GenerateVisitors<BaseVisitor, 4> SuperClass;
+    typedef typename VisitorTypes<BaseVisitor>::Average::MomentsType MomentsType;
 
     template <typename DistType>
     BaseVisitor* generate(const DistType& d, const std::string& className,
@@ -586,9 +589,9 @@ namespace BedMap {
       PT pt(precision, useScientific);
 
       if ( nm == visName<typename VTypes::Average>() )
-        rtn = new typename VTypes::Average(pt);
+        rtn = new typename VTypes::Average(pt, moments());
       else if ( nm == visName<typename VTypes::CoeffVariation>() )
-        rtn = new typename VTypes::CoeffVariation(pt);
+        rtn = new typename VTypes::CoeffVariation(pt, moments());
       else if ( nm == visName<typename VTypes::EchoMapScore>() ) {
         typedef typename VTypes::EchoMapScore::ProcessType PT;
         rtn = new typename VTypes::EchoMapScore(PT(pt, multivalColSep, onEmptyMap));
@@ -639,9 +642,9 @@ namespace BedMap {
         rtn = new typename VTypes::MinElementStable(MPT(precision, useScientific, onEmptyMap));
       }
       else if ( nm == visName<typename VTypes::StdDev>() )
-        rtn = new typename VTypes::StdDev(pt);
+        rtn = new typename VTypes::StdDev(pt, moments());
       else if ( nm == visName<typename VTypes::Sum>() )
-        rtn = new typename VTypes::Sum(pt);
+        rtn = new typename VTypes::Sum(pt, moments());
       else if ( nm == visName<typename VTypes::TMean>() ) {
         Ext::Assert<Ext::UserError>(2 == args.size(), "Need two values with " + nm);
         std::stringstream conv1(args[0]), conv2(args[1]);
@@ -651,12 +654,22 @@ namespace BedMap {
         rtn = new typename VTypes::TMean(percentileLow, percentileHigh, pt);
       }
       else if ( nm == visName<typename VTypes::Variance>() )
-        rtn = new typename VTypes::Variance(pt);
+        rtn = new typename VTypes::Variance(pt, moments());
       else if ( nm == visName<typename VTypes::WMean>() )
         rtn = new typename VTypes::WMean(pt);
 
       return rtn;
     }
+
+  private:
+    // --sum --mean --variance --stdev --cv all keep one set of running moments
+    typename MomentsType::Shared& moments() {
+      if ( !moments_ )
+        moments_ = std::make_shared<MomentsType>();
+      return moments_;
+    }
+
+    typename MomentsType::Shared moments_;
   };
 
 
@@ -695,12 +708,12 @@ namespace BedMap {
 
   template <>
   struct SelectBED<4, true> {
-    typedef Bed::BTAllRest::Bed4Type BType;
+    typedef Bed::B4RestLazy BType; // id/rest parsed only for rows that get used
   };
 
   template <>
   struct SelectBED<5, true> {
-    typedef Bed::BTAllRest::Bed5Type BType;
+    typedef Bed::B5RestLazy BType; // score/id/rest parsed only for rows that get used
   };
 
 
@@ -999,4 +1012,190 @@ namespace BedMap {
     }
   }
 
+
+  //==============
+  // runMapping()
+  //==============
+  template <typename InputType>
+  void runMapping(const InputType& input, const std::string& chrom) {
+      std::vector<std::string> visitorNames = input.visitorNames_;
+      std::vector< std::vector<std::string> > visitorArgs = input.visitorArgs_;
+      const int prec = input.precision_;
+      const bool sci = input.useScientific_;
+      BedMap::minimumMemory = input.useMinMemory_;
+      BedMap::ioThreads = input.ioThreads_;
+
+      // if all Starch inputs and no nested elements, then can use --faster if the
+      //   overlap criterion allows it.
+      const bool starchFast = !BedMap::checkStarchNesting(input.refFileName_, input.mapFileName_);
+      const bool nestCheck = input.errorCheck_ && input.fastMode_;
+
+      if ( input.isPercMap_ ) { // % overlap relative to MapType's size (signalmapish)
+        Bed::PercentOverlapMapping bedDist(input.percOvr_);
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else if ( input.isPercRef_ ) { // % overlap relative to RefTypes's size (setops -e)
+        Bed::PercentOverlapReference bedDist(input.percOvr_);
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else if ( input.isPercBoth_ ) { // % overlap relative to both MapType's and RefType's sizes
+        Bed::PercentOverlapBoth bedDist(input.percOvr_);
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else if ( input.isExact_ ) { // must be identical coordinates; should work fine with fully-nested elements
+        Bed::Exact bedDist;
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        const bool fastMode = true;
+        const bool noNestCheck = false; // safe with fully-nested elements
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, noNestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, fastMode,
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else if ( input.isPercEither_ ) { // % overlap relative to either MapType's or RefType's size
+        Bed::PercentOverlapEither bedDist(input.percOvr_);
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, input.fastMode_,
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else if ( input.isRangeBP_ ) { // buffer each reference element
+        Bed::RangedDist bedDist(input.rangeBP_);
+        Bed::RangedDist sweepDist(input.rangeBP_); // same as bedDist in this case
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, (input.fastMode_ || starchFast),
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      } else { // require a certain amount of bp overlap
+        Bed::Overlapping bedDist(input.overlapBP_);
+        Bed::Overlapping sweepDist(0); // dist type for sweep different from BedBaseVisitor's
+        BedMap::selectSweep(sweepDist, bedDist, input.refFileName_, input.mapFileName_,
+                            input.minRefFields_, input.minMapFields_, input.errorCheck_, nestCheck,
+                            input.outDelim_, input.multiDelim_, input.unmappedVal_, prec, sci, (input.fastMode_ || starchFast),
+                            input.sweepAll_, chrom, input.skipUnmappedRows_, visitorNames, visitorArgs);
+      }
+  }
+
+  //===============
+  // runParallel() : map each chromosome of <ref-file> in its own child process,
+  //                  up to --threads at a time.  A child's output goes to an
+  //                  unlinked temporary file that is copied to stdout once all
+  //                  earlier chromosomes are written, preserving sorted order.
+  //                  Processes, rather than threads, keep the file-scope
+  //                  memory pools and buffered output private to a worker.
+  //===============
+  template <typename InputType>
+  void runParallel(const InputType& input) {
+    typedef Ext::UserError EType;
+    Ext::Assert<EType>(!named_pipe(input.refFileName_) && !named_pipe(input.mapFileName_),
+                       "--threads requires regular files, not named pipes");
+
+    std::vector<std::string> chroms;
+    {
+      Ext::FPWrap<Ext::InvalidFile> refFile(input.refFileName_);
+      chroms = Bed::list_chromosomes(refFile);
+    }
+
+    const std::size_t nchroms = chroms.size();
+    const std::size_t maxRunning = static_cast<std::size_t>(input.threads_);
+    const std::size_t maxPending = maxRunning + 256; // bounds open descriptors
+    const char* tmpdir = std::getenv("TMPDIR");
+    const std::string tmpl = std::string((tmpdir && *tmpdir) ? tmpdir : "/tmp") + "/bedmap.XXXXXX";
+
+    std::vector<pid_t> pids(nchroms, 0);
+    std::vector<int> fds(nchroms, -1);
+    std::vector<bool> done(nchroms, false);
+    std::size_t next = 0, emitted = 0, running = 0;
+
+    auto cleanup = [&]() {
+      for ( std::size_t i = emitted; i < next; ++i ) {
+        if ( !done[i] ) {
+          kill(pids[i], SIGTERM);
+          waitpid(pids[i], NULL, 0);
+        }
+        close(fds[i]);
+      }
+    };
+
+    try {
+      while ( emitted < nchroms ) {
+        while ( running < maxRunning && next < nchroms && next - emitted < maxPending ) {
+          std::vector<char> name(tmpl.begin(), tmpl.end());
+          name.push_back('\0');
+          const int fd = mkstemp(&name[0]);
+          Ext::Assert<EType>(fd != -1, "Unable to create temporary file: " + tmpl);
+          unlink(&name[0]);
+          Ext::StdOut().flush();
+          std::fflush(stdout); // nothing buffered may leak into a child
+          const pid_t pid = fork();
+          if ( pid == -1 ) {
+            close(fd);
+            throw(EType("Unable to fork a process for --threads"));
+          } else if ( pid == 0 ) { // child
+            int rtn = EXIT_FAILURE;
+            try {
+              if ( dup2(fd, STDOUT_FILENO) != -1 ) {
+                close(fd);
+                runMapping(input, chroms[next]);
+                rtn = EXIT_SUCCESS;
+              }
+            } catch(std::string& s) {
+              std::cerr << "Error: " << s << std::endl;
+            } catch(const std::exception& stx) {
+              std::cerr << "Error: " << stx.what() << std::endl;
+            } catch(...) {
+              std::cerr << "Unknown Error.  Aborting" << std::endl;
+            }
+            Ext::StdOut().flush(); // _exit() skips thread_local destructors
+            if ( std::fflush(stdout) != 0 )
+              rtn = EXIT_FAILURE;
+            _exit(rtn);
+          }
+          pids[next] = pid;
+          fds[next] = fd;
+          ++next;
+          ++running;
+        } // while
+
+        // copy out every finished chromosome with no unfinished predecessor
+        while ( emitted < next && done[emitted] ) {
+          char buf[1 << 16];
+          ssize_t n = 0;
+          lseek(fds[emitted], 0, SEEK_SET);
+          while ( (n = read(fds[emitted], buf, sizeof(buf))) > 0 )
+            std::fwrite(buf, 1, static_cast<std::size_t>(n), stdout);
+          Ext::Assert<EType>(n == 0, "Unable to read temporary output for chromosome " + chroms[emitted]);
+          close(fds[emitted]);
+          ++emitted;
+        } // while
+        if ( emitted == nchroms )
+          break;
+
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, 0);
+        if ( pid == -1 )
+          continue;
+        const std::size_t idx = std::find(pids.begin() + emitted, pids.begin() + next, pid) - pids.begin();
+        if ( idx == next )
+          continue;
+        done[idx] = true;
+        --running;
+        Ext::Assert<EType>(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS,
+                           "--threads: failed to process chromosome " + chroms[idx]);
+      } // while
+    } catch(...) {
+      cleanup();
+      throw;
+    }
+    std::fflush(stdout);
+  }
+
 } // namespace BedMap
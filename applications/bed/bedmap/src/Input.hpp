@@ -79,7 +79,7 @@ namespace BedMap {
         precision_(6), useScientific_(false), useMinMemory_(false), setPrec_(false), numFiles_(0),
         minRefFields_(0), minMapFields_(0), errorCheck_(false), sweepAll_(false),
         outDelim_("|"), multiDelim_(";"), fastMode_(false), rangeAlias_(false),
-        chrom_("all"), skipUnmappedRows_(false), unmappedVal_("") {
+        chrom_("all"), skipUnmappedRows_(false), unmappedVal_(""), threads_(1), setThreads_(false), ioThreads_(0) {
 
       // Process user's operation options
       if ( argc <= 1 )
@@ -148,6 +148,25 @@ namespace BedMap {
           conv >> precision_;
           Ext::Assert<ArgError>(precision_ >= 0, "--prec value must be >= 0");
           setPrec_ = true;
+        } else if ( next == "threads" ) {
+          Ext::Assert<ArgError>(argcntr < argc, "No value given for --threads");
+          Ext::Assert<ArgError>(!setThreads_, "--threads specified multiple times.");
+          std::string sval = argv[argcntr++];
+          Ext::Assert<ArgError>(sval.find_first_not_of(posIntegers) == std::string::npos,
+                                "Non-positive-integer argument: " + sval + " for --threads");
+          std::stringstream conv(sval);
+          conv >> threads_;
+          Ext::Assert<ArgError>(threads_ > 0, "--threads value must be > 0");
+          setThreads_ = true;
+        } else if ( next == "io-threads" ) {
+          Ext::Assert<ArgError>(argcntr < argc, "No value given for --io-threads");
+          Ext::Assert<ArgError>(ioThreads_ == 0, "--io-threads specified multiple times.");
+          std::string sval = argv[argcntr++];
+          Ext::Assert<ArgError>(sval.find_first_not_of(posIntegers) == std::string::npos,
+                                "Non-positive-integer argument: " + sval + " for --io-threads");
+          std::stringstream conv(sval);
+          conv >> ioThreads_;
+          Ext::Assert<ArgError>(ioThreads_ > 0, "--io-threads value must be > 0");
         } else if ( next == "bp-ovr" ) {
           // first check that !rangeAlias_ before !isOverlapBP_
           Ext::Assert<ArgError>(!rangeAlias_, "--range and --bp-ovr detected.  Choose one.");
@@ -372,6 +391,22 @@ namespace BedMap {
       }
       Ext::Assert<ArgError>(refFileName_ != "-" || mapFileName_ != "-",
                             "Cannot have stdin set for two files");
+
+      // --threads works chromosome by chromosome, jumping within each input
+      if ( threads_ > 1 ) {
+        Ext::Assert<ArgError>(chrom_ == "all", "--threads and --chrom are incompatible");
+        Ext::Assert<ArgError>(refFileName_ != "-" && mapFileName_ != "-", "--threads requires files, not stdin");
+        Ext::Assert<ArgError>(!errorCheck_, "--threads is incompatible with --ec and --header");
+        const std::string rowid = details::name<typename VT::EchoRefRowNumber>();
+        Ext::Assert<ArgError>(std::find(visitorNames_.begin(), visitorNames_.end(), rowid) == visitorNames_.end(),
+                              "--threads is incompatible with --" + rowid);
+      }
+
+      // --io-threads reads ahead through the fast, pooled iterators only
+      if ( ioThreads_ > 0 ) {
+        Ext::Assert<ArgError>(!errorCheck_, "--io-threads is incompatible with --ec and --header");
+        Ext::Assert<ArgError>(!useMinMemory_, "--io-threads is incompatible with --min-memory");
+      }
     }
 
 
@@ -406,6 +441,9 @@ namespace BedMap {
     std::string chrom_;
     bool skipUnmappedRows_;
     std::string unmappedVal_;
+    int threads_;
+    bool setThreads_;
+    int ioThreads_;
 
   private:
     struct MapFields {
@@ -481,12 +519,17 @@ namespace BedMap {
     usage << "                              --bp-ovr, --range, --fraction-both, and --exact overlap options only. \n";
     usage << "      --header              Accept headers (VCF, GFF, SAM, BED, WIG) in any input file.             \n";
     usage << "      --help                Print this message and exit successfully.                               \n";
+    usage << "      --io-threads <int>    Read and parse up to <int> inputs (<ref-file> first) on threads of      \n";
+    usage << "                              their own, ahead of the mapping.  Incompatible with --ec and          \n";
+    usage << "                              --min-memory.                                                         \n";
     usage << "      --min-memory          Minimize memory usage (slower).                                         \n";
     usage << "      --multidelim <delim>  Change delimiter of multi-value output columns from ';' to <delim>.     \n";
     usage << "      --prec <int>          Change the post-decimal precision of scores to <int>.  0 <= <int>.      \n";
     usage << "      --sci                 Use scientific notation for score outputs.                              \n";
     usage << "      --skip-unmapped       Print no output for a row with no mapped elements.                      \n";
     usage << "      --sweep-all           Ensure <map-file> is read completely (helps to prevent broken pipes).   \n";
+    usage << "      --threads <int>       Process up to <int> chromosomes at once.  Output order is unchanged.    \n";
+    usage << "                              Requires regular files and is incompatible with --chrom and --ec.     \n";
     usage << "      --unmapped-val <val>  Print <val> on unmapped --echo-map* and --min/max-element* operations.  \n";
     usage << "                              The default is to print nothing.                                      \n";
     usage << "      --version             Print program information.                                              \n";
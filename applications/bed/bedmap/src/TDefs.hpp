@@ -24,7 +24,10 @@
 #ifndef _BEDMAP_TYPEDEFS_HPP
 #define _BEDMAP_TYPEDEFS_HPP
 
+#include <type_traits>
+
 #include "algorithm/visitors/BedVisitors.hpp"
+#include "algorithm/visitors/OtherVisitors.hpp"
 #include "algorithm/visitors/helpers/ProcessBedVisitorRow.hpp"
 #include "algorithm/visitors/helpers/ProcessVisitorRow.hpp"
 #include "data/bed/BedCompare.hpp"
@@ -67,40 +70,50 @@ namespace BedMap {
     typedef Bed::ScoreThenGenomicCompareGreater<MapType, MapType> MaxOrderStable; // on ties, return first genomic element observed (only first kept on value+genomic ties)
     typedef Bed::ScoreThenGenomicCompareLesser<MapType, MapType> MinOrderStable;  // on ties, return first genomic element observed (only first kept on value+genomic ties)
 
-    typedef Visitors::Average<ProcessScorePrecision, BaseClass> Average;
-    typedef Visitors::CoeffVariation<ProcessScorePrecision, BaseClass> CoeffVariation;
-    typedef Visitors::Count<ProcessScore, BaseClass> Count;
-    typedef Visitors::Indicator<ProcessScore, BaseClass> Indicator;
-    typedef Visitors::RollingKthAverage<ProcessScorePrecision, BaseClass, Ext::ArgumentError> KthAverage;
-    typedef Visitors::Extreme<ProcessScorePrecision, BaseClass, MaxOrderArb> Max;
-    typedef Visitors::Median<ProcessScorePrecision, BaseClass> Median;
-    typedef Visitors::MedianAbsoluteDeviation<ProcessScorePrecision, BaseClass> MedianAbsoluteDeviation;
-    typedef Visitors::Extreme<ProcessScorePrecision, BaseClass, MinOrderArb> Min;
-    typedef Visitors::StdDev<ProcessScorePrecision, BaseClass> StdDev;
-    typedef Visitors::Sum<ProcessScorePrecision, BaseClass> Sum;
-    typedef Visitors::TrimmedMean<ProcessScorePrecision, BaseClass, Ext::ArgumentError> TMean;
-    typedef Visitors::WeightedAverage<ProcessScorePrecision, BaseClass> WMean;
-    typedef Visitors::Variance<ProcessScorePrecision, BaseClass> Variance;
+    // fast mode (no nested elements) sweeps delete map items in the order they
+    //  were added, which lets max/min use a monotonic deque instead of a set
+    enum { FifoDeletes = std::is_same<BaseClass, Visitors::Visitor<RefType, MapType>>::value };
+    template <typename Process, typename CompType>
+    using ExtremeType = typename std::conditional<FifoDeletes,
+                                                  Visitors::MonotonicExtreme<Process, BaseClass, CompType>,
+                                                  Visitors::Extreme<Process, BaseClass, CompType>
+                                                 >::type;
+
+    // Batched<>: a whole run of adds/deletes per virtual call through MultiVisitor
+    typedef Visitors::Batched<Visitors::Average<ProcessScorePrecision, BaseClass>> Average;
+    typedef Visitors::Batched<Visitors::CoeffVariation<ProcessScorePrecision, BaseClass>> CoeffVariation;
+    typedef Visitors::Batched<Visitors::Count<ProcessScore, BaseClass>> Count;
+    typedef Visitors::Batched<Visitors::Indicator<ProcessScore, BaseClass>> Indicator;
+    typedef Visitors::Batched<Visitors::RollingKthAverage<ProcessScorePrecision, BaseClass, Ext::ArgumentError>> KthAverage;
+    typedef Visitors::Batched<ExtremeType<ProcessScorePrecision, MaxOrderArb>> Max;
+    typedef Visitors::Batched<Visitors::Median<ProcessScorePrecision, BaseClass>> Median;
+    typedef Visitors::Batched<Visitors::MedianAbsoluteDeviation<ProcessScorePrecision, BaseClass>> MedianAbsoluteDeviation;
+    typedef Visitors::Batched<ExtremeType<ProcessScorePrecision, MinOrderArb>> Min;
+    typedef Visitors::Batched<Visitors::StdDev<ProcessScorePrecision, BaseClass>> StdDev;
+    typedef Visitors::Batched<Visitors::Sum<ProcessScorePrecision, BaseClass>> Sum;
+    typedef Visitors::Batched<Visitors::TrimmedMean<ProcessScorePrecision, BaseClass, Ext::ArgumentError>> TMean;
+    typedef Visitors::Batched<Visitors::WeightedAverage<ProcessScorePrecision, BaseClass>> WMean;
+    typedef Visitors::Batched<Visitors::Variance<ProcessScorePrecision, BaseClass>> Variance;
 
-    typedef Visitors::Extreme<ProcessOne, BaseClass, MaxOrderRand, Visitors::RandTie> MaxElementRand;
-    typedef Visitors::Extreme<ProcessOne, BaseClass, MinOrderRand, Visitors::RandTie> MinElementRand;
-    typedef Visitors::Extreme<ProcessOne, BaseClass, MaxOrderStable> MaxElementStable;
-    typedef Visitors::Extreme<ProcessOne, BaseClass, MinOrderStable> MinElementStable;
+    typedef Visitors::Batched<Visitors::Extreme<ProcessOne, BaseClass, MaxOrderRand, Visitors::RandTie>> MaxElementRand;
+    typedef Visitors::Batched<Visitors::Extreme<ProcessOne, BaseClass, MinOrderRand, Visitors::RandTie>> MinElementRand;
+    typedef Visitors::Batched<ExtremeType<ProcessOne, MaxOrderStable>> MaxElementStable;
+    typedef Visitors::Batched<ExtremeType<ProcessOne, MinOrderStable>> MinElementStable;
 
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimAll, BaseClass> EchoMapAll;
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimID, BaseClass> EchoMapID;
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimLength, BaseClass> EchoMapLength;
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessMapGenomicRange, BaseClass> EchoMapRange;
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimScorePrecision, BaseClass> EchoMapScore;
-    typedef Visitors::BedSpecific::EchoMapBed<ProcessUniqueDelimID, BaseClass> EchoMapUniqueID;
-    typedef Visitors::BedSpecific::EchoMapIntersectLength<ProcessRangeDelimIntersectLength, BaseClass> EchoMapIntersectLength;
-    typedef Visitors::Echo<ProcessAll, BaseClass> EchoRefAll;
-    typedef Visitors::Echo<ProcessLength, BaseClass> EchoRefLength;
-    typedef Visitors::Echo<ProcessSpanName, BaseClass> EchoRefSpan;
-    typedef Visitors::Echo<ProcessRowID, BaseClass> EchoRefRowNumber;
-    typedef Visitors::BedSpecific::OvrAggregate<ProcessScore, BaseClass> OvrAgg;
-    typedef Visitors::BedSpecific::OvrUnique<ProcessScore, BaseClass> OvrUniq;
-    typedef Visitors::BedSpecific::OvrUniqueFract<ProcessScorePrecision, BaseClass> OvrUniqFract;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimAll, BaseClass>> EchoMapAll;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimID, BaseClass>> EchoMapID;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimLength, BaseClass>> EchoMapLength;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessMapGenomicRange, BaseClass>> EchoMapRange;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessRangeDelimScorePrecision, BaseClass>> EchoMapScore;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapBed<ProcessUniqueDelimID, BaseClass>> EchoMapUniqueID;
+    typedef Visitors::Batched<Visitors::BedSpecific::EchoMapIntersectLength<ProcessRangeDelimIntersectLength, BaseClass>> EchoMapIntersectLength;
+    typedef Visitors::Batched<Visitors::Echo<ProcessAll, BaseClass>> EchoRefAll;
+    typedef Visitors::Batched<Visitors::Echo<ProcessLength, BaseClass>> EchoRefLength;
+    typedef Visitors::Batched<Visitors::Echo<ProcessSpanName, BaseClass>> EchoRefSpan;
+    typedef Visitors::Batched<Visitors::Echo<ProcessRowID, BaseClass>> EchoRefRowNumber;
+    typedef Visitors::Batched<Visitors::BedSpecific::OvrAggregate<ProcessScore, BaseClass>> OvrAgg;
+    typedef Visitors::Batched<Visitors::BedSpecific::OvrUnique<ProcessScore, BaseClass>> OvrUniq;
+    typedef Visitors::Batched<Visitors::BedSpecific::OvrUniqueFract<ProcessScorePrecision, BaseClass>> OvrUniqFract;
 
   };
 
@@ -119,7 +119,7 @@ struct BedPadReader {
 
   inline BedType* ReadLine() {
     static const bool done = false;
-    static BedType* tmp = static_cast<BedType*>(0);
+    BedType* tmp = static_cast<BedType*>(0);
     static const IterType end;
 
     // lpad_ may be +, rpad_ may be -.  In either case, padding may cause an element to become
@@ -22,6 +22,8 @@
 //
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
@@ -30,13 +32,16 @@
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <mutex>
 #include <numeric>
 #include <queue>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "algorithm/bed/ListChromosomes.hpp"
 #include "algorithm/visitors/helpers/ProcessBedVisitorRow.hpp"
 #include "data/bed/AllocateIterator_BED_starch.hpp"
 #include "data/bed/BedCheckIterator.hpp"
@@ -44,9 +49,11 @@
 #include "data/bed/BedTypes.hpp"
 #include "suite/BEDOPS.Constants.hpp"
 #include "suite/BEDOPS.Version.hpp"
+#include "utility/ConcurrentPooledMemory.hpp"
 #include "utility/Exception.hpp"
 #include "utility/FPWrap.hpp"
-#include "utility/PooledMemory.hpp"
+#include "utility/LoserTree.hpp"
+#include "utility/OrderedOutput.hpp"
 #include "utility/Typify.hpp"
 
 #include "BedPadReader.hpp"
@@ -62,9 +69,14 @@ namespace { // unnamed
   static const PType NADA_NOTHING = std::make_pair(1, 0);
 
   constexpr std::size_t PoolSz = 512; // could be many input files though all will share through get_pool()
-  constexpr bool NODESTRUCT = false;
-  Ext::PooledMemory<Bed::B3Rest, PoolSz, NODESTRUCT> memRest;
-  Ext::PooledMemory<Bed::B3NoRest, PoolSz, NODESTRUCT> memNoRest;
+  // each --threads worker and --io-threads reader builds records from a heap of its own
+  template <typename BedType>
+  using PoolType = Ext::ConcurrentPooledMemory<BedType, PoolSz>;
+  PoolType<Bed::B3Rest> memRest;
+  PoolType<Bed::B3NoRest> memNoRest;
+
+  // set while a --threads worker runs; record() writes here instead of stdout
+  thread_local Ext::OrderedOutput::Buffer* sink = nullptr;
 
   inline
   void Remove(Bed::B3Rest* p) {
@@ -187,7 +199,10 @@ void clean(Cont& c) {
 template <typename BedType>
 inline void record(BedType* b) {
   static Visitors::BedHelpers::Println printer;
-  printer.operator()(b);
+  if ( sink )
+    b->println(*sink);
+  else
+    printer.operator()(b);
 }
 
 //===================
@@ -213,19 +228,69 @@ struct GetType {
                   Bed::GenomicAddressCompare<BedType, BedType>
                              > PQ;
 
-  template <typename BedType>
-  struct InvertedBedWithFileIdx : public Bed::InvertGenomicRestAddressCompare<BedType, BedType> {
-    typedef Bed::InvertGenomicRestAddressCompare<BedType, BedType> Base;
-    inline bool operator()(std::pair<BedType*, int>& p1, std::pair<BedType*, int>& p2) {
-      return Base::operator()(p1.first, p2.first);
-    }
-  };
+  // union keeps every column, so equal coordinates are ordered on the rest
+  typedef typename std::conditional<BedType::UseRest,
+                                    Bed::GenomicRestCompare<BedType, BedType>,
+                                    Bed::GenomicCompare<BedType, BedType>
+                                   >::type RestCompare;
+};
 
-  // use when BedType has full_rest() and you need to keep track of which file it came from
-  typedef std::priority_queue<
-                  std::pair<BedType*, int>, std::vector<std::pair<BedType*, int>>,
-                  InvertedBedWithFileIdx<BedType>
-                             > IPQ_Rest;
+//==============
+// peekLine<T> : next element of a file, left in place
+//==============
+template <typename BedFile>
+inline typename BedFile::BedType* peekLine(BedFile& bedFile) {
+  typename BedFile::BedType* bt = bedFile.ReadLine(); // 0 at the end, as HasNext() would find
+  if ( bt )
+    bedFile.PushBack(bt);
+  return(bt);
+}
+
+//=====================
+// MergeFiles<BedFiles> : the next elements of bedFiles[start, end) in an
+//                         Ext::LoserTree, so finding the least of k files
+//                         takes log2(k) comparisons rather than k.  Each
+//                         element stays at the front of its own file, just as
+//                         a scan for the minimum leaves it; top() and file()
+//                         name the least one and where it sits.  Once that
+//                         file has been read from, pop() or update() brings
+//                         the tree up to date.  Files other than file() must
+//                         not be read from in between.
+//                        Ties go to the lower file index.
+//=====================
+template <typename BedFiles, typename Compare = Bed::GenomicCompare<typename GetType<BedFiles>::BedType,
+                                                                    typename GetType<BedFiles>::BedType>>
+struct MergeFiles {
+  typedef typename GetType<BedFiles>::BedType BedType;
+  typedef typename BedFiles::value_type FileType;
+
+  MergeFiles(BedFiles& bedFiles, std::size_t start, std::size_t end)
+    : files_(bedFiles), start_(start), tree_(end - start) {
+    for ( std::size_t i = start; i < end; ++i )
+      tree_.set(i - start, peekLine(*files_[i]));
+    tree_.build();
+  }
+
+  inline BedType* top() const { return(tree_.top()); }
+  inline FileType file() const { return(files_[start_ + tree_.top_index()]); }
+
+  // take top() from its file; 0 once all files are done
+  inline BedType* pop() {
+    if ( !tree_.any() )
+      return(static_cast<BedType*>(0));
+    FileType f = file();
+    BedType* bt = f->ReadLine();
+    tree_.replace_top(peekLine(*f));
+    return(bt);
+  }
+
+  // file() was read from directly
+  inline void update() { tree_.replace_top(peekLine(*file())); }
+
+private:
+  BedFiles& files_;
+  const std::size_t start_;
+  Ext::LoserTree<BedType*, Compare> tree_;
 };
 
 //=============
@@ -268,7 +333,7 @@ struct createWork;
 //=================
 template <typename IterType1, typename IterType2>
 struct createWork {
-  static void run(const Input& input) {
+  static void run(const Input& input, const std::string& chrom) {
     typedef Ext::FPWrap<Ext::InvalidFile> FPType;
     typedef BedPadReader<IterType1> BedReaderType1;
     typedef BedPadReader<IterType2> BedReaderType2;
@@ -285,10 +350,10 @@ struct createWork {
       nextFilePtr = new FPType(input.GetFileName(i));
       filePointers.push_back(nextFilePtr);
       if ( 0 == i ) {
-        IterType1 fileI(*nextFilePtr, mem1, input.Chrom());
+        IterType1 fileI(*nextFilePtr, mem1, chrom, i < input.IOThreads());
         refFile = new BedReaderType1(fileI, 0, 0); // never pad sole reference file
       } else {
-        IterType2 t(*nextFilePtr, mem2, input.Chrom());
+        IterType2 t(*nextFilePtr, mem2, chrom, i < input.IOThreads());
         bedFiles.push_back(new BedReaderType2(t, input.GetLeftPad(), input.GetRightPad()));
       }
     } // for
@@ -314,7 +379,7 @@ struct createWork {
 //================================
 template <typename IterType>
 struct createWork<IterType, IterType> {
-  static void run(const Input& input) {
+  static void run(const Input& input, const std::string& chrom) {
     typedef Ext::FPWrap<Ext::InvalidFile> FPType;
     typedef BedPadReader<IterType> BedReaderType;
     typedef std::vector<BedReaderType*> BedReaderContainer;
@@ -326,7 +391,7 @@ struct createWork<IterType, IterType> {
     for ( int i = 0; i < input.NumberFiles(); ++i ) {
       nextFilePtr = new FPType(input.GetFileName(i));
       filePointers.push_back(nextFilePtr);
-      IterType t(*nextFilePtr, mem, input.Chrom());
+      IterType t(*nextFilePtr, mem, chrom, i < input.IOThreads());
       bedFiles.push_back(new BedReaderType(t, input.GetLeftPad(), input.GetRightPad()));
     } // for
 
@@ -345,16 +410,16 @@ struct createWork<IterType, IterType> {
 //=================
 // createWork<T,U> : specialization for error checking
 //=================
-template <typename BedType1, typename BedType2, std::size_t Sz>
-struct createWork< Bed::bed_check_iterator<BedType1*, Sz>, Bed::bed_check_iterator<BedType2*, Sz> > {
-  static void run(const Input& input) {
+template <typename BedType1, typename BedType2, std::size_t Sz, typename Pool1, typename Pool2>
+struct createWork< Bed::bed_check_iterator<BedType1*, Sz, Pool1>, Bed::bed_check_iterator<BedType2*, Sz, Pool2> > {
+  static void run(const Input& input, const std::string& chrom) {
     typedef std::ifstream* StreamPtr;
-    typedef Bed::bed_check_iterator<BedType1*, Sz> IterType1;
-    typedef Bed::bed_check_iterator<BedType2*, Sz> IterType2;
+    typedef Bed::bed_check_iterator<BedType1*, Sz, Pool1> IterType1;
+    typedef Bed::bed_check_iterator<BedType2*, Sz, Pool2> IterType2;
     typedef BedPadReader<IterType1> BedReaderType1;
     typedef BedPadReader<IterType2> BedReaderType2;
     typedef std::vector<BedReaderType2*> BedReaderContainer;
-    typedef typename Bed::bed_check_iterator<BedType1*, Sz>::Exception Error;
+    typedef typename IterType1::Exception Error;
 
     StreamPtr nextFilePtr = static_cast<StreamPtr>(0);
     std::vector<StreamPtr> filePointers;
@@ -373,22 +438,22 @@ struct createWork< Bed::bed_check_iterator<BedType1*, Sz>, Bed::bed_check_iterat
 
       if ( 0 == i ) {
         if ( isStdin ) {
-          IterType1 fileI(std::cin, "stdin", mem1, input.Chrom());
+          IterType1 fileI(std::cin, "stdin", mem1, chrom);
           refFile = new BedReaderType1(fileI, 0, 0); // never pad sole Reference File
         } else {
           if ( !nextFilePtr || !(*nextFilePtr) )
             throw(Error("Unable to find file: " + input.GetFileName(i)));
-          IterType1 fileI(*nextFilePtr, input.GetFileName(i), mem1, input.Chrom());
+          IterType1 fileI(*nextFilePtr, input.GetFileName(i), mem1, chrom);
           refFile = new BedReaderType1(fileI, 0, 0); // never pad sole Reference File
         }
       } else {
         if ( isStdin ) {
-          IterType2 fileI(std::cin, "stdin", mem2, input.Chrom());
+          IterType2 fileI(std::cin, "stdin", mem2, chrom);
           bedFiles.push_back(new BedReaderType2(fileI, input.GetLeftPad(), input.GetRightPad()));
         } else {
           if ( !nextFilePtr || !(*nextFilePtr) )
             throw(Error("Unable to find file: " + input.GetFileName(i)));
-          IterType2 fileI(*nextFilePtr, input.GetFileName(i), mem2, input.Chrom());
+          IterType2 fileI(*nextFilePtr, input.GetFileName(i), mem2, chrom);
           bedFiles.push_back(new BedReaderType2(fileI, input.GetLeftPad(), input.GetRightPad()));
         }
       }
@@ -414,14 +479,14 @@ struct createWork< Bed::bed_check_iterator<BedType1*, Sz>, Bed::bed_check_iterat
 //=================
 // createWork<T,T> : specialization for error checking
 //=================
-template <typename BedType, std::size_t Sz>
-struct createWork< Bed::bed_check_iterator<BedType*, Sz>, Bed::bed_check_iterator<BedType*, Sz> > {
-  static void run(const Input& input) {
+template <typename BedType, std::size_t Sz, typename Pool>
+struct createWork< Bed::bed_check_iterator<BedType*, Sz, Pool>, Bed::bed_check_iterator<BedType*, Sz, Pool> > {
+  static void run(const Input& input, const std::string& chrom) {
     typedef std::ifstream* StreamPtr;
-    typedef Bed::bed_check_iterator<BedType*, Sz> IterType;
+    typedef Bed::bed_check_iterator<BedType*, Sz, Pool> IterType;
     typedef BedPadReader<IterType> BedReaderType;
     typedef std::vector<BedReaderType*> BedReaderContainer;
-    typedef typename Bed::bed_check_iterator<BedType*, Sz>::Exception Error;
+    typedef typename IterType::Exception Error;
 
     StreamPtr nextFilePtr = static_cast<StreamPtr>(0);
     std::vector<StreamPtr> filePointers;
@@ -432,14 +497,14 @@ struct createWork< Bed::bed_check_iterator<BedType*, Sz>, Bed::bed_check_iterato
       // Create file handle iterators
       bool isStdin = (input.GetFileName(i) == "-");
       if ( isStdin ) {
-        IterType fileI(std::cin, "stdin", mem, input.Chrom());
+        IterType fileI(std::cin, "stdin", mem, chrom);
         bedFiles.push_back(new BedReaderType(fileI, input.GetLeftPad(), input.GetRightPad()));
       } else {
         nextFilePtr = new std::ifstream(input.GetFileName(i).c_str());
         filePointers.push_back(nextFilePtr);
         if ( !nextFilePtr || !(*nextFilePtr) )
           throw(Error("Unable to find file: " + input.GetFileName(i)));
-        IterType fileI(*nextFilePtr, input.GetFileName(i), mem, input.Chrom());
+        IterType fileI(*nextFilePtr, input.GetFileName(i), mem, chrom);
         bedFiles.push_back(new BedReaderType(fileI, input.GetLeftPad(), input.GetRightPad()));
       }
     } // for
@@ -461,54 +526,116 @@ struct createWork< Bed::bed_check_iterator<BedType*, Sz>, Bed::bed_check_iterato
 //==========
 // doWork()
 //==========
-void doWork(const Input& input) {
+void doWork(const Input& input, const std::string& chrom) {
   ModeType mode = input.GetModeType();
   const bool errorCheck = input.ErrorCheck();
   if ( mode == UNIONALL ) { // Keep all columns in all files
     typedef Bed::B3Rest BedType;
     if ( errorCheck )
-      createWork< Bed::bed_check_iterator<BedType*, PoolSz> >::run(input);
+      createWork< Bed::bed_check_iterator<BedType*, PoolSz, PoolType<BedType>> >::run(input, chrom);
     else
-      createWork< Bed::allocate_iterator_starch_bed<BedType*, PoolSz> >::run(input);
+      createWork< Bed::allocate_iterator_starch_bed<BedType*, PoolSz, PoolType<BedType>> >::run(input, chrom);
   }
   else if ( mode == ELEMENTOF || mode == NOTELEMENTOF ) { // Keep all columns only in first file
     typedef Bed::B3Rest BedType1;
     typedef Bed::B3NoRest BedType2;
     if ( errorCheck )
-      createWork< Bed::bed_check_iterator<BedType1*, PoolSz>,
-                  Bed::bed_check_iterator<BedType2*, PoolSz> >::run(input);
+      createWork< Bed::bed_check_iterator<BedType1*, PoolSz, PoolType<BedType1>>,
+                  Bed::bed_check_iterator<BedType2*, PoolSz, PoolType<BedType2>> >::run(input, chrom);
     else
-      createWork< Bed::allocate_iterator_starch_bed<BedType1*, PoolSz>,
-                  Bed::allocate_iterator_starch_bed<BedType2*, PoolSz> >::run(input);
+      createWork< Bed::allocate_iterator_starch_bed<BedType1*, PoolSz, PoolType<BedType1>>,
+                  Bed::allocate_iterator_starch_bed<BedType2*, PoolSz, PoolType<BedType2>> >::run(input, chrom);
   }
   else { // Only use 3 columns
     typedef Bed::B3NoRest BedType;
     if ( errorCheck )
-      createWork< Bed::bed_check_iterator<BedType*, PoolSz> >::run(input);
+      createWork< Bed::bed_check_iterator<BedType*, PoolSz, PoolType<BedType>> >::run(input, chrom);
     else
-      createWork< Bed::allocate_iterator_starch_bed<BedType*, PoolSz> >::run(input);
+      createWork< Bed::allocate_iterator_starch_bed<BedType*, PoolSz, PoolType<BedType>> >::run(input, chrom);
   }
 }
 
+//==============
+// doParallel() : --threads.  Workers take chromosomes in sort-bed order from
+//                 the union of all inputs, and each reads every input with
+//                 the --chrom machinery.  Ext::OrderedOutput puts results
+//                 back together in that order.
+//==============
+void doParallel(const Input& input) {
+  std::vector<std::string> chroms;
+  for ( int i = 0; i < input.NumberFiles(); ++i ) {
+    Ext::FPWrap<Ext::InvalidFile> f(input.GetFileName(i));
+    std::vector<std::string> c = Bed::list_chromosomes(f);
+    chroms.insert(chroms.end(), c.begin(), c.end());
+  } // for
+  auto lt = [](const std::string& a, const std::string& b) { return std::strcmp(a.c_str(), b.c_str()) < 0; };
+  std::sort(chroms.begin(), chroms.end(), lt);
+  chroms.erase(std::unique(chroms.begin(), chroms.end()), chroms.end());
+
+  Ext::OrderedOutput out(chroms.size());
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto work = [&]() {
+    std::size_t idx = 0;
+    while ( !failed && (idx = next++) < chroms.size() ) {
+      try {
+        sink = &out[idx];
+        doWork(input, chroms[idx]);
+        sink = nullptr;
+        out.done(idx);
+      } catch(...) {
+        sink = nullptr;
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if ( !error )
+          error = std::current_exception();
+        failed = true;
+      }
+    } // while
+  };
+
+  const std::size_t nthreads = std::min(chroms.size(), static_cast<std::size_t>(input.Threads()));
+  std::vector<std::thread> workers;
+  for ( std::size_t i = 0; i < nthreads; ++i )
+    workers.push_back(std::thread(work));
+  for ( std::size_t i = 0; i < workers.size(); ++i )
+    workers[i].join();
+  std::fflush(stdout);
+  if ( error )
+    std::rethrow_exception(error);
+}
+
+//==========
+// doWork()
+//==========
+void doWork(const Input& input) {
+  if ( input.Threads() > 1 )
+    doParallel(input);
+  else
+    doWork(input, input.Chrom());
+}
+
 //==========
 // doChop()
 //==========
 template <typename BedFiles>
-typename GetType<BedFiles>::BedType* nextMergeAllLines(int start, int end, BedFiles&);
+typename GetType<BedFiles>::BedType* nextMergeAllLines(MergeFiles<BedFiles>&);
 
 template <typename BedFiles>
 void doChop(BedFiles& bedFiles, Bed::CoordType chunkSize, Bed::CoordType stagger, bool excludeEndShort) {
   typedef typename GetType<BedFiles>::BedType BedType;
   static BedType* const zero = static_cast<BedType*>(0);
+  MergeFiles<BedFiles> files(bedFiles, 0, bedFiles.size());
   BedType c;
   BedType* r = zero;
   bool done = false;
   while ( !done ) {
-    r = nextMergeAllLines(0, bedFiles.size(), bedFiles);
+    r = nextMergeAllLines(files);
     if ( !r )
       break;
     for ( auto i = r->start(); i < r->end(); ) {
-      if ( 0 != std::strcmp(c.chrom(), r->chrom()) )
+      if ( 0 != Bed::chromcmp(&c, r) )
         c.chrom(r->chrom());
       c.start(i);
       c.end(i+chunkSize);
@@ -532,15 +659,16 @@ void doChop(BedFiles& bedFiles, Bed::CoordType chunkSize, Bed::CoordType stagger
 // doComplement()
 //================
 template <typename BedFiles>
-std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(BedFiles&, bool);
+std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(MergeFiles<BedFiles>&, bool);
 
 template <typename BedFiles>
 void doComplement(BedFiles& bedFiles, bool fullLeft) {
   typedef typename GetType<BedFiles>::BedType BedType;
+  MergeFiles<BedFiles> files(bedFiles, 0, bedFiles.size());
   bool done = false;
   std::pair<bool, BedType*> nextline;
   while ( !done ) {
-    nextline = nextComplementLine(bedFiles, fullLeft);
+    nextline = nextComplementLine(files, fullLeft);
     if ( !nextline.second )
       break;
     else if ( !nextline.first ) {
@@ -556,6 +684,7 @@ void doComplement(BedFiles& bedFiles, bool fullLeft) {
 template <typename BedFiles>
 std::pair<bool, typename GetType<BedFiles>::BedType*>
   nextDifferenceLine(BedFiles&,
+                     MergeFiles<BedFiles>&,
                      typename GetType<BedFiles>::BedType*&,
                      typename GetType<BedFiles>::BedType*&);
 
@@ -568,10 +697,11 @@ void doDifference(BedFiles& bedFiles) {
 
   bool done = false;
   std::pair<bool, BedType*> nextline = std::make_pair(false, zero);
+  MergeFiles<BedFiles> nonRefFiles(bedFiles, noRefIdx, bedFiles.size());
   BedType* nextRefMerge = zero;
-  BedType* nextNonRefMerge = nextMergeAllLines(noRefIdx, bedFiles.size(), bedFiles);
+  BedType* nextNonRefMerge = nextMergeAllLines(nonRefFiles);
   while ( !done ) {
-    nextline = nextDifferenceLine(bedFiles, nextRefMerge, nextNonRefMerge);
+    nextline = nextDifferenceLine(bedFiles, nonRefFiles, nextRefMerge, nextNonRefMerge);
     if ( !nextline.second )
       break;
     else if ( !nextline.first ) {
@@ -594,7 +724,7 @@ typename BedFile::BedType* getNextFileLine(BedFile&);
 
 template <typename RefFile, typename NonRefFiles>
 std::pair<bool, typename RefFile::BedType*>
-    nextElementOfLine(typename RefFile::BedType*&, RefFile&, NonRefFiles&,
+    nextElementOfLine(typename RefFile::BedType*&, RefFile&, MergeFiles<NonRefFiles>&,
                       std::deque<typename GetType<NonRefFiles>::BedType*>&,
                       double, bool, bool);
 
@@ -607,12 +737,13 @@ void doElementOf(RefFile& refFile, NonRefFiles& nonRefBedFiles, double thres, bo
   std::deque<NonRefBedType*> q;
   std::pair<bool, RefBedType*> r;
   RefBedType* nextRef = zero;
-  NonRefBedType* tmp = nextMergeAllLines(0, nonRefBedFiles.size(), nonRefBedFiles);
+  MergeFiles<NonRefFiles> nonRefFiles(nonRefBedFiles, 0, nonRefBedFiles.size());
+  NonRefBedType* tmp = nextMergeAllLines(nonRefFiles);
   if ( tmp )
     q.push_back(tmp);
   bool done = false;
   while ( !done ) {
-    std::pair<bool, RefBedType*> r = nextElementOfLine(nextRef, refFile, nonRefBedFiles, q, thres, usePerc, invert);
+    std::pair<bool, RefBedType*> r = nextElementOfLine(nextRef, refFile, nonRefFiles, q, thres, usePerc, invert);
     if ( !nextRef )
       break;
     else if ( !r.first && r.second )
@@ -656,10 +787,11 @@ template <typename BedFiles>
 void doMerge(BedFiles& bedFiles) {
   typedef typename GetType<BedFiles>::BedType BedType;
   static BedType* const zero = static_cast<BedType*>(0);
+  MergeFiles<BedFiles> files(bedFiles, 0, bedFiles.size());
   BedType* r = zero;
   bool done = false;
   while ( !done ) {
-    r = nextMergeAllLines(0, bedFiles.size(), bedFiles);
+    r = nextMergeAllLines(files);
     if ( !r )
       break;
     record(r);
@@ -672,17 +804,18 @@ void doMerge(BedFiles& bedFiles) {
 // doPartitions()
 //================
 template <typename BedFiles, typename PQueue>
-void nextPartitionGroup(BedFiles& bedFiles, PQueue& pq);
+void nextPartitionGroup(MergeFiles<BedFiles>& files, PQueue& pq);
 
 template <typename BedFiles>
 void doPartitions(BedFiles& bedFiles) {
   typedef typename GetType<BedFiles>::BedType BedType;
   const bool done = false;
-  typename GetType<BedFiles>::IPQ pq;
+  MergeFiles<BedFiles> files(bedFiles, 0, bedFiles.size());
+  typename GetType<BedFiles>::IPQ pq; // pieces of one group of overlapping elements
 
   BedType* z = static_cast<BedType*>(0);
   while ( !done ) {
-    nextPartitionGroup(bedFiles, pq);
+    nextPartitionGroup(files, pq);
     if ( pq.empty() )
       break;
 
@@ -780,7 +913,7 @@ void doSymmetricDifference(BedFiles& bedFiles) {
     else if ( nextDiff.first )
       nextDiff = std::make_pair(false, zero);
     else {
-      if ( !toRecord || std::strcmp(toRecord->chrom(), nextDiff.second->chrom()) != 0 ) {
+      if ( !toRecord || Bed::chromcmp(toRecord, nextDiff.second) != 0 ) {
         if ( !first && toRecord ) {
           record(toRecord);
           Remove(toRecord);
@@ -810,17 +943,9 @@ void doSymmetricDifference(BedFiles& bedFiles) {
     Remove(toRecord);
 }
 
-//=================================
-// doUnionAll() and doUnionAllPQ()
-//=================================
-template <typename BedFiles>
-typename std::enable_if<GetType<BedFiles>::BedType::UseRest, typename GetType<BedFiles>::BedType>::type*
-nextUnionAllLine(BedFiles&); /* requires BedType::UseRest to be true */
-
-template <typename BedFiles>
-typename std::enable_if<!GetType<BedFiles>::BedType::UseRest, typename GetType<BedFiles>::BedType>::type*
-nextUnionAllLine(BedFiles&); /* unimplemented on purpose */
-
+//==============
+// doUnionAll()
+//==============
 template <typename BedFiles>
 void doUnionAll(BedFiles& bedFiles) {
   /* If inputs have duplicate entries, output will too */
@@ -839,51 +964,14 @@ void doUnionAll(BedFiles& bedFiles) {
     return;
   }
 
-  const bool done = false;
-  while ( !done ) {
-    r = nextUnionAllLine(bedFiles);
-    if ( !r )
-      break;
+  // full ties (every column) go to the earlier file, though they print the same
+  MergeFiles<BedFiles, typename GetType<BedFiles>::RestCompare> files(bedFiles, 0, bedFiles.size());
+  while ( (r = files.pop()) ) {
     record(r);
     Remove(r);
   } // while
 }
 
-template <typename BedFiles>
-void doUnionAllPQ(BedFiles& bedFiles) {
-  /* meant for cases with large numbers of input files (50+ maybe) */
-  /* If inputs have duplicate entries, output will too */
-  typedef typename GetType<BedFiles>::BedType BedType;
-  typename GetType<BedFiles>::IPQ_Rest pq; // union uses full_rest()
-  static BedType* const zero = static_cast<BedType*>(0);
-
-  BedType* r = zero;
-  if ( 1 == bedFiles.size() ) {
-    /* a simple cat command, possibly post-padded as
-         dealt with in BedPadReader. */
-    while ( bedFiles[0]->HasNext() ) {
-      r = bedFiles[0]->ReadLine();
-      record(r);
-      bedFiles[0]->Remove(r);
-    } // while
-    return;
-  }
-
-  for ( std::size_t i = 0; i < bedFiles.size(); ++i ) {
-    if ( bedFiles[i]->HasNext() )
-      pq.push(std::make_pair(bedFiles[i]->ReadLine(), i));
-  } // for
-
-  while ( !pq.empty() ) {
-    const std::pair<BedType*, int> val = pq.top();
-    pq.pop();
-    record(val.first);
-    bedFiles[val.second]->Remove(val.first);
-    if ( bedFiles[val.second]->HasNext() )
-      pq.push(std::make_pair(bedFiles[val.second]->ReadLine(), val.second));
-  } // while
-}
-
 //===========================
 // getNextFileMergedCoords()
 //===========================
@@ -931,10 +1019,10 @@ typename BedFile::BedType* getNextFileLine(BedFile& bedFile) {
 template <typename BedFiles>
 typename GetType<BedFiles>::BedType*
     getNextMerge(std::deque<typename GetType<BedFiles>::BedType*>& mergeList,
-                 int start, int end, BedFiles& bedFiles) {
+                 MergeFiles<BedFiles>& files) {
   typedef typename GetType<BedFiles>::BedType BedType;
   if ( mergeList.empty() )
-    return(nextMergeAllLines(start, end, bedFiles));
+    return(nextMergeAllLines(files));
   BedType* toRtn = mergeList.front();
   mergeList.pop_front();
   return(toRtn);
@@ -965,7 +1053,7 @@ BedType* mergeOverlap(const BedType* p1, const BedType* p2) {
   static BedType* const zero = static_cast<BedType*>(0);
   BedType* toRtn = zero;
 
-  if ( 0 != std::strcmp(p1->chrom(), p2->chrom()) ) {
+  if ( 0 != Bed::chromcmp(p1, p2) ) {
     return(toRtn);
   } else if ( p1->start() < p2->start() ) {
     if ( p1->end() >= p2->start() ) {
@@ -988,13 +1076,13 @@ BedType* mergeOverlap(const BedType* p1, const BedType* p2) {
 // nextComplementLine()
 //======================
 template <typename BedFiles>
-std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(BedFiles& bedFiles, bool fullLeft) {
+std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(MergeFiles<BedFiles>& files, bool fullLeft) {
   typedef typename GetType<BedFiles>::BedType BedType;
   static BedType* zero = static_cast<BedType*>(0);
   static BedType* last = static_cast<BedType*>(0);
 
   if ( last == zero ) {
-    last = nextMergeAllLines(0, bedFiles.size(), bedFiles);
+    last = nextMergeAllLines(files);
     if ( last == zero ) // stop condition
       return(std::make_pair(false, zero));
     else if ( fullLeft ) {
@@ -1010,14 +1098,14 @@ std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(BedFile
       }
     }
   }
-  BedType* nextline = nextMergeAllLines(0, bedFiles.size(), bedFiles);
+  BedType* nextline = nextMergeAllLines(files);
   if ( nextline == zero ) { // stop condition
     Remove(last);
     last = zero;
     return(std::make_pair(false, zero));
   }
 
-  if ( 0 != std::strcmp(nextline->chrom(), last->chrom()) ) {
+  if ( 0 != Bed::chromcmp(nextline, last) ) {
     Remove(last);
     last = nextline;
     if ( fullLeft ) { // chrom change -> first complement starts at base 0
@@ -1033,7 +1121,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(BedFile
     }
     return(std::make_pair(true, last));
     // direct recursion removed to prevent any possible stack overflow
-    // return(nextComplementLine(bedFiles, fullLeft); // curse some more
+    // return(nextComplementLine(files, fullLeft); // curse some more
   }
 
   BedType* toRtn = last;
@@ -1049,6 +1137,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*> nextComplementLine(BedFile
 template <typename BedFiles>
 std::pair<bool, typename GetType<BedFiles>::BedType*>
     nextDifferenceLine(BedFiles& bedFiles,
+                       MergeFiles<BedFiles>& nonRefFiles,
                        typename GetType<BedFiles>::BedType*& nextRefMerge,
                        typename GetType<BedFiles>::BedType*& nextNonRefMerge) {
 
@@ -1056,7 +1145,6 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
   typedef typename GetType<BedFiles>::BedType BedType;
   static BedType* const zero = static_cast<BedType*>(0);
   static const int ref = 0;
-  static const int noRef = 1;
   static const bool callAgain = true;
   static const bool noRecurse = false;
 
@@ -1074,13 +1162,13 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
     return(std::make_pair(noRecurse, zero));
 
   // Increment nextNonRefMerge until its back within range of nextRefMerge
-  int cmp = std::strcmp(nextNonRefMerge->chrom(), nextRefMerge->chrom());
+  int cmp = Bed::chromcmp(nextNonRefMerge, nextRefMerge);
   while ( cmp < 0 || (0 == cmp && nextNonRefMerge->end() <= nextRefMerge->start()) ) {
     Remove(nextNonRefMerge);
-    nextNonRefMerge = nextMergeAllLines(noRef, bedFiles.size(), bedFiles);
+    nextNonRefMerge = nextMergeAllLines(nonRefFiles);
     if ( !nextNonRefMerge ) // always true after first true
       return(std::make_pair(noRecurse, nextRefMerge));
-    cmp = std::strcmp(nextNonRefMerge->chrom(), nextRefMerge->chrom());
+    cmp = Bed::chromcmp(nextNonRefMerge, nextRefMerge);
   } // while
 
   // Compare orientation of nextNonRefMerge and nextRefMerge
@@ -1093,7 +1181,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
     nextRefMerge = getNextFileMergedCoords(*bedFiles[ref]);
     return(std::make_pair(callAgain, nextRefMerge)); // possible for nextRefMerge to be zero
     // direct recursion removed to prevent any possible stack overflow
-    // return(nextDifferenceLine(bedFiles, nextRefMerge, nextNonRefMerge)); // curse some more
+    // return(nextDifferenceLine(bedFiles, nonRefFiles, nextRefMerge, nextNonRefMerge)); // curse some more
   } else if ( nextNonRefMerge->start() > nextRefMerge->start() ) {
     /* difference found up to nextNonRefMerge->start() */
     BedType* toRtn = CopyCreate(nextRefMerge);
@@ -1105,7 +1193,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
       nextRefMerge = getNextFileMergedCoords(*bedFiles[ref]);
       if ( !nextRefMerge )
         break;
-      cmp = std::strcmp(nextNonRefMerge->chrom(), nextRefMerge->chrom());
+      cmp = Bed::chromcmp(nextNonRefMerge, nextRefMerge);
     } // while
     return(std::make_pair(noRecurse, toRtn));
   } else { // nextNonRefMerge->start() <= nextRefMerge->start()
@@ -1113,7 +1201,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
     nextRefMerge->start(nextNonRefMerge->end());
     return(std::make_pair(callAgain, nextRefMerge));
     // direct recursion removed to prevent any possible stack overflow
-    // return(nextDifferenceLine(bedFiles, nextRefMerge, nextNonRefMerge)); // curse some more
+    // return(nextDifferenceLine(bedFiles, nonRefFiles, nextRefMerge, nextNonRefMerge)); // curse some more
   }
 }
 
@@ -1124,7 +1212,7 @@ template <typename RefFile, typename NonRefFiles>
 std::pair<bool, typename RefFile::BedType*>
     nextElementOfLine(typename RefFile::BedType*& nextRef,
                       RefFile& refFile,
-                      NonRefFiles& nonRefBedFiles,
+                      MergeFiles<NonRefFiles>& nonRefFiles,
                       std::deque<typename GetType<NonRefFiles>::BedType*>& mergeList,
                       double threshold, bool usePercent, bool invert) {
 
@@ -1140,7 +1228,7 @@ std::pair<bool, typename RefFile::BedType*>
   if ( !nextRef )
     nextRef = getNextFileLine(refFile);
 
-  NonRefBedType* nextMerge = getNextMerge(mergeList, 0, nonRefBedFiles.size(), nonRefBedFiles);
+  NonRefBedType* nextMerge = getNextMerge(mergeList, nonRefFiles);
   if ( !nextMerge ) {
     if ( !invert ) // ref cannot be an element of nothing
       return(std::make_pair(noRecurse, zero));
@@ -1148,16 +1236,16 @@ std::pair<bool, typename RefFile::BedType*>
   }
 
   // Increment nextMerge until its back within range of nextRef
-  int cmp = std::strcmp(nextMerge->chrom(), nextRef->chrom());
+  int cmp = Bed::chromcmp(nextMerge, nextRef);
   while ( cmp < 0 || (0 == cmp && nextMerge->end() <= nextRef->start()) ) {
     Remove(nextMerge);
-    nextMerge = getNextMerge(mergeList, 0, nonRefBedFiles.size(), nonRefBedFiles);
+    nextMerge = getNextMerge(mergeList, nonRefFiles);
     if ( !nextMerge ) {
       if ( !invert ) // ref cannot be an element of nothing
         return(std::make_pair(noRecurse, zero));
       return(std::make_pair(noRecurse, nextRef));
     }
-    cmp = std::strcmp(nextMerge->chrom(), nextRef->chrom());
+    cmp = Bed::chromcmp(nextMerge, nextRef);
   } // while
 
   bool done = false;
@@ -1175,11 +1263,11 @@ std::pair<bool, typename RefFile::BedType*>
       PType lap = intersectOverlap(make_coords(nextMerge), make_coords(nextRef));
       rangeOverlap += lap.second - lap.first;
       // don't delete nextMerge -> in queue
-      nextMerge = getNextMerge(mergeList, 0, nonRefBedFiles.size(), nonRefBedFiles);
+      nextMerge = getNextMerge(mergeList, nonRefFiles);
       if ( !nextMerge )
         break;
       toPush.push_back(nextMerge);
-      cmp = std::strcmp(nextMerge->chrom(), nextRef->chrom());
+      cmp = Bed::chromcmp(nextMerge, nextRef);
     }
   } // while
 
@@ -1225,7 +1313,7 @@ typename GetType<BedFiles>::BedType* nextIntersectLine(BedFiles& bedFiles) {
       continue;
     }
 
-    int val = std::strcmp(next->chrom(), toRtn->chrom());
+    int val = Bed::chromcmp(next, toRtn);
     if ( 0 == val ) {
       if ( next->start() > toRtn->start() )
         toRtn = next;
@@ -1246,7 +1334,7 @@ typename GetType<BedFiles>::BedType* nextIntersectLine(BedFiles& bedFiles) {
 
     next = getNextFileMergedCoords(*bedFiles[i]);
 
-    int val = std::strcmp(next->chrom(), toRtn->chrom());
+    int val = Bed::chromcmp(next, toRtn);
     while ( val < 0 || (val == 0 && next->end() <= toRtn->start()) ) {
       Remove(next);
       next = getNextFileMergedCoords(*bedFiles[i]);
@@ -1254,7 +1342,7 @@ typename GetType<BedFiles>::BedType* nextIntersectLine(BedFiles& bedFiles) {
         Remove(toRtn);
         return(zero);
       }
-      val = std::strcmp(next->chrom(), toRtn->chrom());
+      val = Bed::chromcmp(next, toRtn);
     } // while
 
     bedFiles[i]->PushBack(next);
@@ -1285,61 +1373,29 @@ typename GetType<BedFiles>::BedType* nextIntersectLine(BedFiles& bedFiles) {
 //====================
 template <typename BedFiles>
 typename GetType<BedFiles>::BedType*
-nextMergeAllLines(int start, int end, BedFiles& bedFiles) {
+nextMergeAllLines(MergeFiles<BedFiles>& files) {
 
   // Merge coordinates between files
   typedef typename GetType<BedFiles>::BedType BedType;
   static BedType* const zero = static_cast<BedType*>(0);
-  BedType* toRtn = zero;
-  BedType* bt = zero;
-  bool anyNew = false;
-  int minimum = start;
-
-  // First find a minimum bed item (unmerged within a single file)
-  int val = 0;
-  for ( int i = start; i < end; ++i ) { // find minimum
-    if ( bedFiles[i]->HasNext() ) {
-      anyNew = true;
-      bt = bedFiles[i]->ReadLine();
-      bedFiles[i]->PushBack(bt);
-      if ( !toRtn || (val = std::strcmp(bt->chrom(), toRtn->chrom())) < 0 ) {
-        minimum = i;
-        toRtn = bt;
-      } else if ( 0 == val && bt->start() < toRtn->start() ) {
-        minimum = i;
-        toRtn = bt;
-      }
-    }
-  } // for
-  if ( !anyNew )
-    return(zero);
-  toRtn = bedFiles[minimum]->ReadLine(); // undo PushBack above for this file only
-  bt = zero;
 
-  // Increment bedfiles in search of contiguous pieces
-  for ( int i = start; i < end; ++i ) {
-    if ( !bedFiles[i]->HasNext() )
-      continue;
-    bt = bedFiles[i]->ReadLine();
-    while ( 0 == (val = std::strcmp(bt->chrom(), toRtn->chrom())) && bt->end() <= toRtn->end() ) {
-      bedFiles[i]->Remove(bt);
-      bt = bedFiles[i]->ReadLine();
-      if ( !bt )
-        break;
-    } // while
+  // Minimum bed item (unmerged within a single file)
+  BedType* toRtn = files.pop();
+  if ( !toRtn )
+    return(zero);
 
-    // New max end coordinate?
-    if ( bt &&
-         0 == val &&
-         bt->start() <= toRtn->end() &&
-         bt->end() > toRtn->end() ) {
-      toRtn->end(bt->end());
-      bedFiles[i]->Remove(bt);
-      i = (start - 1); // start over on next iteration
-    } else if ( bt ) {
-      bedFiles[i]->PushBack(bt);
-    }
-  } // for
+  // Everything from here in sort order that overlaps or abuts toRtn, any file.
+  //  Take a whole run from one file before the tree replays its match.
+  BedType* bt = zero;
+  while ( (bt = files.top()) && 0 == Bed::chromcmp(bt, toRtn) && bt->start() <= toRtn->end() ) {
+    typename MergeFiles<BedFiles>::FileType f = files.file();
+    do {
+      if ( bt->end() > toRtn->end() ) // New max end coordinate
+        toRtn->end(bt->end());
+      f->Remove(f->ReadLine());
+    } while ( (bt = peekLine(*f)) && 0 == Bed::chromcmp(bt, toRtn) && bt->start() <= toRtn->end() );
+    files.update();
+  } // while
   return(toRtn);
 }
 
@@ -1347,51 +1403,31 @@ nextMergeAllLines(int start, int end, BedFiles& bedFiles) {
 // nextPartitionGroup()
 //======================
 template <typename BedFiles, typename PQueue>
-void nextPartitionGroup(BedFiles& bedFiles, PQueue& pq) {
+void nextPartitionGroup(MergeFiles<BedFiles>& files, PQueue& pq) {
 
   typedef typename GetType<BedFiles>::BedType BedType;
-  static BedType* const zero = static_cast<BedType*>(0);
-  BedType* minelem = zero, * bt;
-  std::size_t mn = bedFiles.size();
-
-  // find minimum
-  int val = 1;
-  for ( std::size_t i = 0; i < bedFiles.size(); ++i ) {
-    if ( bedFiles[i]->HasNext() ) {
-      bt = bedFiles[i]->ReadLine();
-      bedFiles[i]->PushBack(bt);
-      if ( !minelem || (val = std::strcmp(bt->chrom(), minelem->chrom())) < 0 ) {
-        if ( mn < bedFiles.size() )
-          bedFiles[mn]->PushBack(minelem);
-        mn = i;
-        minelem = bedFiles[mn]->ReadLine();
-      } else if ((0 == val) &&
-                 ((bt->start() < minelem->start()) ||
-                 ((bt->start() == minelem->start()) && (bt->end() < minelem->end())))) {
-        bedFiles[mn]->PushBack(minelem);
-        mn = i;
-        minelem = bedFiles[mn]->ReadLine();
-      }
-    }
-  } // for
-
+  BedType* minelem = files.pop(), * bt;
   if ( !minelem )
     return;
 
   // find all elements that overlap the min element
   // in return queue, any overlapping element ends that go beyond min element's end,
   //   will be clipped.
-  int sz = static_cast<int>(bedFiles.size());
+  // a file whose next element starts at or after minelem->end() holds nothing for
+  //   this group, and the files are visited in the order of their next elements,
+  //   so the visits stop at the first such file.  Each file is visited once: what
+  //   is left of it afterwards starts at minelem->end() or beyond.
   pq.push(minelem);
-  for ( int i = 0; i < sz; ++i ) {
+  while ( (bt = files.top()) && 0 == Bed::chromcmp(bt, minelem) && bt->start() < minelem->end() ) {
+    typename MergeFiles<BedFiles>::FileType bedFile = files.file();
     typename GetType<BedFiles>::PQ lclQ;
-    while ( bedFiles[i]->HasNext() ) {
-      bt = bedFiles[i]->ReadLine();
-      if ( strcmp(bt->chrom(), minelem->chrom()) != 0 ) { // no overlap
-        bedFiles[i]->PushBack(bt);
+    while ( bedFile->HasNext() ) {
+      bt = bedFile->ReadLine();
+      if ( Bed::chromcmp(bt, minelem) != 0 ) { // no overlap
+        bedFile->PushBack(bt);
         break;
       } else if ( bt->start() > minelem->end() ) { // no overlap
-        bedFiles[i]->PushBack(bt);
+        bedFile->PushBack(bt);
         break;
       } else if ( bt->start() == minelem->end() ) { // no overlap, but be careful
         /* could be that lclQ holds elements that were previously truncated to
@@ -1403,16 +1439,16 @@ void nextPartitionGroup(BedFiles& bedFiles, PQueue& pq) {
 
       if ( bt->start() == minelem->start() ) {
         if ( bt->end() == minelem->end() ) // duplicate
-          bedFiles[i]->Remove(bt);
+          bedFile->Remove(bt);
         else { // bt->end() > minelem->end(), no new info for pq
           bt->start(minelem->end());
           lclQ.push(bt);
-          while ( bedFiles[i]->HasNext() ) {
-            bt = bedFiles[i]->ReadLine();
+          while ( bedFile->HasNext() ) {
+            bt = bedFile->ReadLine();
             if ( bt->start() == minelem->end() )
               lclQ.push(bt);
             else {
-              bedFiles[i]->PushBack(bt);
+              bedFile->PushBack(bt);
               break;
             }
           } // while
@@ -1431,10 +1467,11 @@ void nextPartitionGroup(BedFiles& bedFiles, PQueue& pq) {
     } // while
 
     while ( !lclQ.empty() ) {
-      bedFiles[i]->PushBack(lclQ.top());
+      bedFile->PushBack(lclQ.top());
       lclQ.pop();
     } // while
-  } // for
+    files.update();
+  } // while
 }
 
 //=========================
@@ -1470,7 +1507,7 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
     lookahead = getNextFileMergedCoords(*bedFiles[i]);
     bedFiles[i]->PushBack(lookahead); // only safe due to symmdiff assumptions
 
-    int val = std::strcmp(lookahead->chrom(), min->chrom());
+    int val = Bed::chromcmp(lookahead, min);
     if ( val > 0 )
       continue;
     else if ( val < 0 ) {
@@ -1567,57 +1604,6 @@ std::pair<bool, typename GetType<BedFiles>::BedType*>
   }
 }
 
-//====================
-// nextUnionAllLine()
-//====================
-template <typename BedFiles>
-typename std::enable_if<GetType<BedFiles>::BedType::UseRest, typename GetType<BedFiles>::BedType>::type*
-nextUnionAllLine(BedFiles& bedFiles) {
-  // Find next minimum entry between all files
-  typedef typename GetType<BedFiles>::BedType BedType;
-  static BedType* const zero = static_cast<BedType*>(0);
-  BedType* first = zero;
-  BedType* next = zero;
-  int marker = -1;
-  for ( std::size_t i = 0; i < bedFiles.size(); ++i ) { // find minimum
-    if ( bedFiles[i]->HasNext() ) {
-      if ( !first ) {
-        first = bedFiles[i]->ReadLine();
-        bedFiles[i]->PushBack(first);
-        marker = i;
-        continue;
-      }
-
-      next = bedFiles[i]->ReadLine();
-      bedFiles[i]->PushBack(next);
-      int val = std::strcmp(next->chrom(), first->chrom());
-      if ( val < 0 ) {
-        first = next;
-        marker = i;
-      } else if ( 0 == val ) {
-        if ( next->start() < first->start() ) {
-          first = next;
-          marker = i;
-        } else if ( next->start() == first->start() ) {
-          if ( next->end() < first->end() ) {
-            first = next;
-            marker = i;
-          } else if ( next->end() == first->end() ) {
-            if ( strcmp(next->full_rest(), first->full_rest()) < 0 ) {
-              first = next;
-              marker = i;
-            }
-          }
-        }
-      }
-    }
-  } // for
-
-  if ( marker < 0 )
-    return(zero);
-  return(bedFiles[marker]->ReadLine()); // re-purge cache in bedFiles[marker]
-}
-
 //==============
 // selectWork()
 //==============
@@ -1649,12 +1635,7 @@ void selectWork(const Input& input, BedFiles& bedFiles) {
       doSymmetricDifference(bedFiles);
       break;
     case UNIONALL:
-      if ( GetType<BedFiles>::BedType::UseRest ) {
-        if ( bedFiles.size() < 10 )
-          doUnionAll(bedFiles);
-        else
-          doUnionAllPQ(bedFiles);
-      } // else linker will fail
+      doUnionAll(bedFiles); // only run with BedType::UseRest
       break;
     default:
       throw(Ext::ProgramError("Unsupported mode"));
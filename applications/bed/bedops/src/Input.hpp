@@ -58,7 +58,7 @@ struct Input {
                                  subsetPerc_(1), useSubsetPerc_(true), chopBP_(1),
                                  chopStaggerBP_(0), chopCutShort_(false), errorCheck_(false),
                                  lpad_(0), rpad_(0), leftMost_(0), chrSpecific_(false),
-                                 chr_("all") {
+                                 chr_("all"), threads_(1), ioThreads_(0) {
 
     typedef Ext::UserError UE;
 
@@ -72,6 +72,7 @@ struct Input {
       int argcntr = 1;
       const std::string plusints = "0123456789";
       bool hasRange = false;
+      bool hasThreads = false;
       while ( argcntr < argc ) {
         std::string next = argv[argcntr];
         if ( next == "--ec" ) {
@@ -83,6 +84,25 @@ struct Input {
           Ext::Assert<UE>(++argcntr < argc, "No value for --chrom given.");
           chr_ = argv[argcntr];
           chrSpecific_ = (chr_ != "all");
+        } else if ( next == "--threads" ) {
+          Ext::Assert<UE>(!hasThreads, "--threads specified multiple times.");
+          Ext::Assert<UE>(++argcntr < argc, "No value for --threads given.");
+          next = argv[argcntr];
+          Ext::Assert<UE>(!next.empty() && next.find_first_not_of(plusints) == std::string::npos,
+                          "positive integer value expected for --threads");
+          std::stringstream conv(next);
+          conv >> threads_;
+          Ext::Assert<UE>(threads_ > 0, "--threads value must be > 0");
+          hasThreads = true;
+        } else if ( next == "--io-threads" ) {
+          Ext::Assert<UE>(ioThreads_ == 0, "--io-threads specified multiple times.");
+          Ext::Assert<UE>(++argcntr < argc, "No value for --io-threads given.");
+          next = argv[argcntr];
+          Ext::Assert<UE>(!next.empty() && next.find_first_not_of(plusints) == std::string::npos,
+                          "positive integer value expected for --io-threads");
+          std::stringstream conv(next);
+          conv >> ioThreads_;
+          Ext::Assert<UE>(ioThreads_ > 0, "--io-threads value must be > 0");
         } else if ( next == "--range" ) {
           Ext::Assert<UE>(!hasRange, "--range specified multiple times.");
           Ext::Assert<UE>(++argcntr < argc, "No value for --range given.");
@@ -285,6 +305,15 @@ struct Input {
         ++numFiles_;
       } // for
       Ext::Assert<Ext::UserError>(numFiles_ >= minFiles_, "Not enough files");
+
+      // --threads works chromosome by chromosome, jumping within each input
+      if ( threads_ > 1 ) {
+        Ext::Assert<UE>(ft_ == MERGE || ft_ == UNIONALL, "--threads is supported with -m and -u only");
+        Ext::Assert<UE>(!chrSpecific_, "--threads and --chrom are incompatible");
+        Ext::Assert<UE>(!errorCheck_, "--threads is incompatible with --ec and --header");
+        Ext::Assert<UE>(onlyOne, "--threads requires files, not stdin");
+      }
+      Ext::Assert<UE>(ioThreads_ == 0 || !errorCheck_, "--io-threads is incompatible with --ec and --header");
     } catch(HelpException& he) {
       throw;
     } catch(ExtendedHelpException& ehe) {
@@ -322,6 +351,12 @@ struct Input {
   std::string GetFileName(int i) const {
     return(allFiles_.at(i));
   }
+  int Threads() const {
+    return(threads_);
+  }
+  int IOThreads() const {
+    return(ioThreads_);
+  }
   ModeType GetModeType() const {
     return(ft_);
   }
@@ -448,6 +483,8 @@ private:
   bool leftMost_;
   bool chrSpecific_;
   std::string chr_;
+  int threads_;
+  int ioThreads_;
   std::map<std::string, std::string> options_;
 };
 
@@ -765,12 +802,16 @@ private:
     msg += "          --help               Print this message and exit successfully.\n";
     msg += "          --help-<operation>   Detailed help on <operation>.\n";
     msg += "                                 An example is --help-c or --help-complement\n";
+    msg += "          --io-threads <int>   Read and parse up to <int> input files (in the order\n";
+    msg += "                                 given) on threads of their own, ahead of the operation.\n";
     msg += "          --range L:R          Add 'L' bp to all start coordinates and 'R' bp to end\n";
     msg += "                                 coordinates. Either value may be + or - to grow or\n";
     msg += "                                 shrink regions.  With the -e/-n operations, the first\n";
     msg += "                                 (reference) file is not padded, unlike all other files.\n";
     msg += "          --range S            Pad or shrink input file(s) coordinates symmetrically by S.\n";
     msg += "                                 This is shorthand for: --range -S:S.\n";
+    msg += "          --threads <int>      Process up to <int> chromosomes at once with -m or -u.\n";
+    msg += "                                 Output order is unchanged.  Requires regular files.\n";
     msg += "          --version            Print program information.\n\n";
 
     msg += "      Operations: (choose one of)\n";
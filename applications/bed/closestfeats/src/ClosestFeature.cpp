@@ -268,7 +268,7 @@ inline double getCentroid(BedType* const b) {
 template <typename BedType1, typename BedType2>
 inline Bed::SignedCoordType getDistance(BedType1 const* b1, BedType2 const* b2) {
   int val = 0;
-  if ( 0 != (val = std::strcmp(b1->chrom(), b2->chrom())) )
+  if ( 0 != (val = Bed::chromcmp(b1, b2)) )
     return(val < 0 ? minus_infinite : plus_infinite);
   else if ( b1->end() <= b2->start() )
     return(-1 * static_cast<Bed::SignedCoordType>(b2->start() - b1->end() + 1));
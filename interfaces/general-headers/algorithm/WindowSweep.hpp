@@ -84,6 +84,11 @@ namespace WindowSweep {
          constructor, but may be any constructor with the appropriate
          argument type.  An example could be a constructor taking
          a string, where the iterators passed in point to strings.
+
+    4) EventVisitor receives window changes in runs: OnDeleteBatch()
+         and OnAddBatch() are given an array of pointers and a count.
+         For any one reference, deletions all come before additions.
+         Deleted items are released right after OnDeleteBatch().
   */
 
 } // namespace WindowSweep
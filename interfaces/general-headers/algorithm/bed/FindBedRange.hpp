@@ -39,7 +39,7 @@ namespace Bed {
 
   typedef Bed::SignedCoordType ByteOffset;
 
-  template <class BedType, std::size_t SZ>
+  template <class BedType, std::size_t SZ, class PoolType>
   class bed_check_iterator;
 
   namespace extract_details {
@@ -62,9 +62,9 @@ namespace Bed {
     typedef QueryBedType TargetBedType; // file 2 -> must be same type as QueryBedType
     typedef std::map<QueryBedType, ByteOffset, CompBed<QueryBedType>> MType;
 
-    template <typename BedType, std::size_t Sz>
+    template <typename BedType, std::size_t Sz, typename PoolType>
     inline
-    void remove(Bed::bed_check_iterator<BedType*, Sz>& b, BedType* p)
+    void remove(Bed::bed_check_iterator<BedType*, Sz, PoolType>& b, BedType* p)
       { b.get_pool().release(p); }
 
     template <typename Iter, typename BedType>
@@ -0,0 +1,97 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 03:15:15 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef BED_LIST_CHROMOSOMES_ALGORITHM_H
+#define BED_LIST_CHROMOSOMES_ALGORITHM_H
+
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "algorithm/bed/FindBedRange.hpp"
+#include "algorithm/visitors/helpers/ProcessVisitorRow.hpp"
+#include "data/starch/starchApi.hpp"
+#include "suite/BEDOPS.Constants.hpp"
+#include "utility/FPWrap.hpp"
+
+namespace Bed {
+
+  //====================
+  // list_chromosomes() : chromosomes of a sorted BED file or a Starch archive,
+  //                       in file order.  Starch uses its metadata.  BED jumps
+  //                       chromosome to chromosome with find_bed_range(), as
+  //                       in bedextract --list-chr, and so needs a seekable file.
+  //====================
+  template <typename ErrorType>
+  std::vector<std::string> list_chromosomes(Ext::FPWrap<ErrorType>& fp) {
+    std::vector<std::string> chroms;
+    FILE* f = fp;
+    if ( !f || std::feof(f) )
+      return chroms;
+
+    struct stat st;
+    if ( fp.Name() == "-" || stat(fp.Name().c_str(), &st) == -1 || !S_ISREG(st.st_mode) )
+      throw(ErrorType("Error: need a regular file to list chromosomes from: " + fp.Name()));
+
+    if ( starch::Starch::isStarch(f) ) { // archive takes ownership of, and closes, its own handle
+      FILE* g = std::fopen(fp.Name().c_str(), "r");
+      if ( !g )
+        throw(ErrorType("Error: unable to open: " + fp.Name()));
+      const bool perLineUsage = true;
+      starch::Starch archive(g, "all", perLineUsage);
+      return archive.getChromosomes();
+    }
+
+    std::fseek(f, 0, SEEK_END);
+    const ByteOffset at_end = std::ftell(f);
+    std::rewind(f);
+    if ( at_end == 0 )
+      return chroms;
+
+    typedef extract_details::TargetBedType TargetType;
+    std::vector<TargetType*> v;
+    std::pair<bool, ByteOffset> lbound;
+    Visitors::Helpers::DoNothing nada;
+    while ( true ) {
+      TargetType* bt = new TargetType(f); // find_bed_range cleans up for us
+      chroms.push_back(bt->chrom());
+      bt->start(std::numeric_limits<CoordType>::max()-1);
+      bt->end(std::numeric_limits<CoordType>::max());
+      v.push_back(bt);
+      lbound = find_bed_range(f, v.begin(), v.end(), nada);
+      v.clear(); // bt already deleted
+      if ( !lbound.first || lbound.second == at_end )
+        break;
+      std::fseek(f, lbound.second, SEEK_SET);
+    } // while
+    std::rewind(f);
+    return chroms;
+  }
+
+} // namespace Bed
+
+#endif // BED_LIST_CHROMOSOMES_ALGORITHM_H
@@ -31,6 +31,7 @@
 #include "numerical/IndicatorVisitor.hpp"
 #include "numerical/MedianAbsoluteDeviationVisitor.hpp"
 #include "numerical/MedianVisitor.hpp"
+#include "numerical/MonotonicExtremeVisitor.hpp"
 #include "numerical/RollingKthVisitor.hpp"
 #include "numerical/RollingKthAverageVisitor.hpp"
 #include "numerical/StdevVisitor.hpp"
@@ -25,6 +25,7 @@
 #ifndef _OTHER_WINDOW_VISITOR_TYPES_H
 #define _OTHER_WINDOW_VISITOR_TYPES_H
 
+#include "other/BatchedVisitor.hpp"
 #include "other/EchoVisitor.hpp"
 #include "other/MultiVisitor.hpp"
 
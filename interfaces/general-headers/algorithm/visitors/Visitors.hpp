@@ -24,6 +24,8 @@
 #ifndef SWEEP_VISITORS_HPP
 #define SWEEP_VISITORS_HPP
 
+#include <cstddef>
+
 #include "algorithm/WindowSweep.hpp"
 
 namespace Visitors {
@@ -38,6 +40,8 @@ namespace Visitors {
     inline bool ManagesOwnMemory() const { return(false); }
     inline void OnAdd(MapType* u) { Add(u); }
     inline void OnDelete(MapType* u) { Delete(u); }
+    inline void OnAddBatch(MapType* const* u, std::size_t n) { AddBatch(u, n); }
+    inline void OnDeleteBatch(MapType* const* u, std::size_t n) { DeleteBatch(u, n); }
     inline void OnDone() { DoneReference(); }
     inline void OnEnd() { End(); }
     inline void OnPurge() { Purge(); }
@@ -55,6 +59,13 @@ namespace Visitors {
     virtual void SetReference(RefType*) { /* */ }
     virtual void End() { /* */ }
     virtual void Purge() { /* */ }
+
+    // A run of n items per call.  Override where a whole run can be handled
+    //  more cheaply than one virtual call per item (see Batched<>).
+    virtual void AddBatch(MapType* const* u, std::size_t n)
+      { for ( std::size_t i = 0; i < n; ++i ) Add(u[i]); }
+    virtual void DeleteBatch(MapType* const* u, std::size_t n)
+      { for ( std::size_t i = 0; i < n; ++i ) Delete(u[i]); }
   };
  
 } // namespace Visitors
@@ -24,9 +24,11 @@
 #ifndef _BED_BASE_VISITOR_HPP
 #define _BED_BASE_VISITOR_HPP
 
-#include <list>
-#include <set>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <type_traits>
+#include <vector>
 
 #include "algorithm/WindowSweep.hpp"
 #include "data/bed/BedCompare.hpp"
@@ -123,9 +125,12 @@ namespace Visitors {
 
   protected:
      // typedefs
-     typedef std::set<MapType*, Bed::CoordRestAddressCompare<MapType>> OrderLesser;
-     typedef OrderLesser OrderCache;
-     typedef OrderLesser OrderWin;
+     //  win_ and cache_ are vectors kept sorted under OrderLesser: fixWindow()
+     //  scans both in full for every reference, so contiguous memory beats
+     //  the node-per-element std::set<> used formerly
+     typedef Bed::CoordRestAddressCompare<MapType> OrderLesser;
+     typedef std::vector<MapType*> OrderCache;
+     typedef std::vector<MapType*> OrderWin;
 
   public:
      // Interface for sweep()
@@ -139,17 +144,43 @@ namespace Visitors {
 
      inline void OnAdd(MapType* u) {
        // Add(u); Do not add until deletions done in fixWindow()
-       cache_.insert(u);
+       OnAddBatch(&u, 1);
      }
 
      inline void OnDelete(MapType* u) {
-       static typename OrderWin::iterator winIter;
-       winIter = win_.find(u);
-       if ( winIter != win_.end() ) { // update
-         Delete(u);
-         win_.erase(winIter);
-       } else {
-         cache_.erase(u);
+       OnDeleteBatch(&u, 1);
+     }
+
+     void OnAddBatch(MapType* const* u, std::size_t n) {
+       // sweep() hands these over in file order, which is nearly always
+       //  OrderLesser order too; sort/merge only what is not
+       const std::size_t old = cache_.size();
+       cache_.insert(cache_.end(), u, u + n);
+       auto mid = cache_.begin() + old;
+       if ( !std::is_sorted(mid, cache_.end(), comp_) )
+         std::sort(mid, cache_.end(), comp_);
+       if ( old && comp_(*mid, *(mid - 1)) )
+         std::inplace_merge(cache_.begin(), mid, cache_.end(), comp_);
+     }
+
+     void OnDeleteBatch(MapType* const* u, std::size_t n) {
+       // find everything first, then compact each of win_ and cache_ once
+       for ( std::size_t i = 0; i < n; ++i ) {
+         if ( std::binary_search(win_.begin(), win_.end(), u[i], comp_) ) // update
+           batch_.push_back(u[i]);
+         else
+           scratch_.push_back(u[i]);
+       } // for
+       if ( !scratch_.empty() ) {
+         eraseFrom(cache_, scratch_);
+         scratch_.clear();
+       }
+       if ( !batch_.empty() ) {
+         scratch_.assign(batch_.begin(), batch_.end());
+         eraseFrom(win_, scratch_);
+         scratch_.clear();
+         DeleteBatch(&batch_[0], batch_.size());
+         batch_.clear();
        }
      }
 
@@ -179,49 +210,113 @@ namespace Visitors {
      virtual void DoneReference() = 0;
      virtual inline void SetReference(RefType*) { /* */ }
      virtual inline void End() { /* */ }
+
+     // A run of n items per call.  Override where a whole run can be handled
+     //  more cheaply than one virtual call per item (see Batched<>).
+     virtual void AddBatch(MapType* const* u, std::size_t n)
+       { for ( std::size_t i = 0; i < n; ++i ) Add(u[i]); }
+     virtual void DeleteBatch(MapType* const* u, std::size_t n)
+       { for ( std::size_t i = 0; i < n; ++i ) Delete(u[i]); }
   
    private:
      void fixWindow() {
        // Deletions must come before insertions for consistency with sweep()
        // Realize that, at a minimum, ref_ has changed -> all time-consuming
        //  checks are necessary
-  
-       // Are any items in the window really out of range of 't'?  See problem 2.
-       static std::list<MapType*> lst;
-       auto winIter = win_.begin();
-       while ( winIter != win_.end() ) {
-         if ( dist_.Map2Ref(*winIter, ref_) != 0 ) {
-           Delete(*winIter);
-           lst.push_back(*winIter);
-           win_.erase(winIter++);
-         } else {
-           ++winIter;
-         }
-       } // while
 
+       // Are any items in the window really out of range of 't'?  See problem 2.
+       //  Keepers are compacted in place; both vectors stay sorted.
+       auto keep = win_.begin();
+       for ( auto winIter = win_.begin(); winIter != win_.end(); ++winIter ) {
+         if ( dist_.Map2Ref(*winIter, ref_) != 0 )
+           batch_.push_back(*winIter);
+         else
+           *keep++ = *winIter;
+       } // for
+       win_.erase(keep, win_.end());
+       const std::size_t ndel = batch_.size();
+       if ( ndel )
+         DeleteBatch(&batch_[0], ndel);
+
+       // Only distances that are Ranged can reach beyond a reference's ends.
+       //  For all others, nothing in cache_ that starts after ref_ ends can
+       //  qualify yet, and nothing that ends before ref_ starts can ever
+       //  qualify again: later references only start further right.  Stop
+       //  the scan at the first and drop the second, so the work per
+       //  reference follows the number of elements overlapping it, not the
+       //  span of the sweep's window (see problem 2 for how wide that gets).
+       keep = cache_.begin();
        auto cacheIter = cache_.begin();
-       while ( cacheIter != cache_.end() ) {
-         if ( 0 == dist_.Map2Ref(*cacheIter, ref_) ) {
-           Add(*cacheIter);
-           win_.insert(*cacheIter);
-           cache_.erase(cacheIter++);
-         } else {
-           ++cacheIter;
-         }
-       } // while
-  
-       cache_.insert(lst.begin(), lst.end());
-       lst.clear();
+       for ( ; cacheIter != cache_.end(); ++cacheIter ) {
+         if ( !DistType::Ranged && (*cacheIter)->start() > ref_->end() )
+           break;
+         if ( 0 == dist_.Map2Ref(*cacheIter, ref_) )
+           batch_.push_back(*cacheIter);
+         else if ( DistType::Ranged || !behind(*cacheIter) )
+           *keep++ = *cacheIter;
+       } // for
+       cache_.erase(keep, cacheIter);
+       const std::size_t nadd = batch_.size() - ndel;
+       if ( nadd )
+         AddBatch(&batch_[ndel], nadd);
+
+       // items moved each way are already sorted; merge them across
+       auto delEnd = batch_.begin() + ndel;
+       if ( !DistType::Ranged )
+         delEnd = std::remove_if(batch_.begin(), delEnd, [this](MapType* m) { return behind(m); });
+       mergeInto(win_, batch_.begin() + ndel, batch_.end());
+       mergeInto(cache_, batch_.begin(), delEnd);
+       batch_.clear();
      }
-  
+
+     // ends before ref_ starts, on the same chromosome
+     inline bool behind(MapType* m) const {
+       return m->end() < ref_->start() && 0 == Bed::chromcmp(m, ref_);
+     }
+
+     // remove the items of 'gone' (reordered here) from sorted 'v'
+     inline void eraseFrom(std::vector<MapType*>& v, std::vector<MapType*>& gone) {
+       if ( gone.size() == 1 ) {
+         auto i = std::lower_bound(v.begin(), v.end(), gone[0], comp_);
+         if ( i != v.end() && *i == gone[0] )
+           v.erase(i);
+         return;
+       }
+       std::sort(gone.begin(), gone.end(), comp_);
+       auto keep = v.begin();
+       auto g = gone.begin();
+       for ( auto i = v.begin(); i != v.end(); ++i ) {
+         while ( g != gone.end() && comp_(*g, *i) )
+           ++g;
+         if ( g != gone.end() && *g == *i )
+           ++g;
+         else
+           *keep++ = *i;
+       } // for
+       v.erase(keep, v.end());
+     }
+
+     template <typename Iter>
+     inline void mergeInto(std::vector<MapType*>& v, Iter b, Iter e) {
+       if ( b == e )
+         return;
+       const std::size_t old = v.size();
+       v.insert(v.end(), b, e);
+       if ( old && comp_(v[old], v[old - 1]) )
+         std::inplace_merge(v.begin(), v.begin() + old, v.end(), comp_);
+     }
+
    private:
-     // MUST use a set with value/address compare here instead of a std::multiset
-     //  This is for deleting elements and making sure multiple rows with the
-     //  same coordinates each receive Delete() calls to derived classes.
+     // MUST order by value/address here, so that no two distinct elements
+     //  compare equal.  This is for deleting elements and making sure multiple
+     //  rows with the same coordinates each receive Delete() calls to derived classes.
+     OrderLesser comp_;
      DistType dist_;
      RefType* ref_;
      OrderCache cache_;
      OrderWin win_;
+     std::vector<MapType*> batch_;
+     std::vector<MapType*> scratch_;
   };
 
 } // namespace Visitors
@@ -49,6 +49,10 @@ namespace Visitors {
     template <typename T>
     struct VisitorName;
 
+    template <typename V>
+    struct VisitorName< Visitors::Batched<V> > : VisitorName<V>
+      { /* same name as the visitor it wraps */ };
+
     template <typename A, typename B>
     struct VisitorName< Visitors::Count<A,B> > {
       static std::string Name()
@@ -109,6 +113,10 @@ namespace Visitors {
         { return "max"; }
     };
 
+    template <typename A, typename B, typename C>
+    struct VisitorName< Visitors::MonotonicExtreme<A,B,C> > : VisitorName< Visitors::Extreme<A,B,C> >
+      { /* max, min, max-element or min-element */ };
+
     template <typename A, typename B>
     struct VisitorName< Visitors::Average<A,B> > {
       static std::string Name()
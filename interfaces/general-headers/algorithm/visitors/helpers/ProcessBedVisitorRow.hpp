@@ -157,14 +157,12 @@ namespace Visitors {
 
       template <typename T>
       void operator()(T* t) const { // could use dis/enable_if for built-ins
-        static char const* format = Formats::Format(t->measurement(), precision_, scientific_);
-        std::printf(format, t->measurement());
+        PrintTypes::Print(t->measurement(), precision_, scientific_);
       }
 
       template <typename T>
       void operator()(const T& t) const {
-        static char const* format = Formats::Format(t, precision_, scientific_);
-        std::printf(format, t);
+        PrintTypes::Print(t, precision_, scientific_);
       }
 
       void operator()(const Signal::NaN& s) const {
@@ -186,7 +184,6 @@ namespace Visitors {
 
       template <typename T>
       void operator()(T* t) const { // could use dis/enable_if for built-ins
-        static char const* format = Formats::Format(t->measurement(), precision_, scientific_);
         PrintTypes::Print(t->chrom());
         PrintTypes::Print('\t');
         PrintTypes::Print(t->start());
@@ -195,7 +192,7 @@ namespace Visitors {
         PrintTypes::Print('\t');
         PrintTypes::Print(t->id());
         PrintTypes::Print('\t');
-        std::printf(format, t->measurement());
+        PrintTypes::Print(t->measurement(), precision_, scientific_);
         printRest(t);
       }
 
@@ -256,16 +253,12 @@ namespace Visitors {
 
       template <typename T>
       void operator()(T* t) const { // could use dis/enable_if for built-ins
-        static std::string f = (std::string(Formats::Format(t->measurement(), precision_, scientific_)) + "\n");
-        static char const* format = f.c_str();
-        std::printf(format, t->measurement());
+        PrintTypes::Println(t->measurement(), precision_, scientific_);
       }
 
       template <typename T>
       void operator()(const T& t) const {
-        static std::string f = (std::string(Formats::Format(t, precision_, scientific_)) + "\n");
-        static char const* format = f.c_str();
-        std::printf(format, t);
+        PrintTypes::Println(t, precision_, scientific_);
       }
 
       void operator()(const Signal::NaN& s) const {
@@ -24,7 +24,10 @@
 #ifndef CLASS_WINDOW_AVERAGE_VISITOR_H
 #define CLASS_WINDOW_AVERAGE_VISITOR_H
 
+#include <memory>
+
 #include "data/measurement/NaN.hpp"
+#include "data/measurement/RunningMoments.hpp"
 #include "data/measurement/SelectMeasureType.hpp"
 
 namespace Visitors {
@@ -39,41 +42,39 @@ namespace Visitors {
     typedef Process ProcessType;
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
+    typedef typename Signal::SelectMeasure<MapType>::MeasureType MT;
+    typedef Signal::RunningMoments<MT> MomentsType;
 
-    explicit Average(const ProcessType& pt = ProcessType())
-        : pt_(pt), sum_(0), counter_(0)
+    explicit Average(const ProcessType& pt = ProcessType(),
+                     const typename MomentsType::Shared& m = typename MomentsType::Shared())
+        : pt_(pt), m_(m ? m : std::make_shared<MomentsType>()), owner_(m_->claim())
       { /* */ }
 
-    inline void Add(MapType* bt) {
-      sum_ += *bt;
-      ++counter_;
-    }
+    inline void Add(MapType* bt)
+      { if ( owner_ ) m_->add(*bt); }
 
-    inline void Delete(MapType* bt) {
-      sum_ -= *bt;
-      --counter_;
-    }
+    inline void Delete(MapType* bt)
+      { if ( owner_ ) m_->remove(*bt); }
 
     inline void DoneReference() {
       static const Signal::NaN nan = Signal::NaN();
-      if ( counter_ > 0 )
-        pt_.operator()(sum_/counter_);
+      if ( m_->count() > 0 )
+        pt_.operator()(m_->mean());
       else
         pt_.operator()(nan);
     }
 
     inline void End() {
-      sum_ = 0;
-      counter_ = 0;
+      if ( owner_ )
+        m_->reset();
     }
 
-    virtual ~Average()
-      { /* */ }
+    virtual ~Average() { /* */ }
 
   protected:
     ProcessType pt_;
-    typename Signal::SelectMeasure<MapType>::MeasureType sum_;
-    int counter_;
+    typename MomentsType::Shared m_; // may be shared with other moment visitors
+    const bool owner_;
   };
 
 } // namespace Visitors
@@ -27,13 +27,12 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
-#include <set>
-#include <vector>
 
-#include "algorithm/visitors/numerical/RollingKthAverageVisitor.hpp"
 #include "data/measurement/NaN.hpp"
 #include "data/measurement/SelectMeasureType.hpp"
 #include "utility/Exception.hpp"
+#include "utility/OrderCompare.hpp"
+#include "utility/OrderStatisticTree.hpp"
 
 namespace Visitors {
 
@@ -56,57 +55,56 @@ namespace Visitors {
             typename BaseVisitor,
             typename ExceptionType = Ext::ArgumentError
            >
-  struct MedianAbsoluteDeviation : RollingKthAverage<
-             Helpers::Keep<typename Signal::SelectMeasure<typename BaseVisitor::MapType>::MeasureType>,
-             BaseVisitor, ExceptionType> {
+  struct MedianAbsoluteDeviation : BaseVisitor {
 
-    typedef typename Signal::SelectMeasure<typename BaseVisitor::MapType>::MeasureType MT;
-    typedef RollingKthAverage<Helpers::Keep<MT>, BaseVisitor, ExceptionType> BaseClass;
+    typedef BaseVisitor BaseClass;
+    typedef typename Signal::SelectMeasure<typename BaseClass::MapType>::MeasureType MT;
     typedef Process ProcessType;
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
+    typedef MapType* PtrType;
 
     // Using default multiplier == 1 // see wikipedia
     explicit MedianAbsoluteDeviation(const ProcessType& pt = ProcessType(), double mult = 1)
-       : BaseClass(0.5, Helpers::Keep<MT>()), pt_(pt), mult_(mult)
+       : pt_(pt), mult_(mult)
       { /* */ }
 
+    inline void Add(PtrType ptr) {
+      scoresBuf_.insert(ptr);
+    }
+
+    inline void Delete(PtrType toRemove) {
+      scoresBuf_.erase(toRemove);
+    }
+
     inline void DoneReference() {
       static const Signal::NaN nan = Signal::NaN();
-      if ( BaseClass::scoresBuf_.size() <= 1 ) {
+      if ( scoresBuf_.size() <= 1 ) {
         pt_.operator()(nan);
         return;
-      }
-
-      BaseClass::DoneReference();
-      MT median = BaseClass::pt_.value_;
-      if ( BaseClass::pt_.isNan_ ) {
-        pt_.operator()(nan);
+      } else if ( std::isnan(score(scoresBuf_.size() - 1)) ) { // Comp sorts any nan last; report it, as --mean would
+        pt_.operator()(score(scoresBuf_.size() - 1));
         return;
       }
 
-      std::vector<MT> vec;
-      typename std::vector<MT>::iterator n = vec.begin();
-      typedef typename BaseClass::ScoreTypeContainer::iterator IterType;
-      for ( IterType i = BaseClass::scoresBuf_.begin(); i != BaseClass::scoresBuf_.end(); ++i )
-        vec.push_back(static_cast<MT>(**i));
-
-      // std::transform(vec.begin(), vec.end(), vec.begin(), std::bind2nd(details::abs_diff<MT>(), median)); # deprecated in C++11
-      std::transform(vec.begin(), vec.end(), vec.begin(), std::bind(details::abs_diff<MT>(), std::placeholders::_1, median));
-      std::size_t sz = vec.size();
+      // same median as RollingKthAverage at 0.5
+      MT median = score(scoresBuf_.size() / 2);
+      if ( scoresBuf_.size() % 2 == 0 )
+        median = (score(scoresBuf_.size() / 2 - 1) + median) / 2.0;
+
+      // The deviations of the (sorted) scores below the median, read from
+      //  the median outward, form one ascending sequence, and those of the
+      //  scores at or above it form another.  Select from the pair of them
+      //  rather than building and partitioning a copy of the window.
+      const std::size_t sz = scoresBuf_.size();
+      const std::size_t below = scoresBuf_.count_prefix([median](PtrType p) { return static_cast<MT>(*p) < median; });
       MT mad = 0;
       if ( sz % 2 == 0 ) {
-        n = vec.begin() + static_cast<std::size_t>(sz / 2.0 - 1);
-        std::nth_element(vec.begin(), n, vec.end());
-        mad = static_cast<MT>(*n);
-        n = vec.begin() + static_cast<std::size_t>(sz / 2.0);
-        std::nth_element(vec.begin(), n, vec.end());
-        mad += static_cast<MT>(*n);
+        mad = kthDeviation(sz / 2 - 1, below, median);
+        mad += kthDeviation(sz / 2, below, median);
         mad /= 2.0;
       } else {
-        n = vec.begin() + static_cast<std::size_t>(std::floor(sz / 2.0));
-        std::nth_element(vec.begin(), n, vec.end());
-        mad = *n;
+        mad = kthDeviation(sz / 2, below, median);
       }
       pt_.operator()(mad * mult_);
     }
@@ -114,8 +112,41 @@ namespace Visitors {
     virtual ~MedianAbsoluteDeviation() { /* */ }
 
   protected:
+    typedef Ordering::CompNumberThenAddressLesser<MapType, MT> Comp; // ties independent of addresses
+    typedef Ext::OrderStatisticTree<PtrType, Comp> ScoreTypeContainer;
+
+    inline MT score(std::size_t k) const
+      { return static_cast<MT>(*scoresBuf_.select(k)); }
+
+    // i-th smallest deviation below the median and at/above it
+    inline MT lower(std::size_t below, MT median, std::size_t i) const
+      { return details::abs_diff<MT>()(score(below - 1 - i), median); }
+    inline MT upper(std::size_t below, MT median, std::size_t i) const
+      { return details::abs_diff<MT>()(score(below + i), median); }
+
+    // k-th smallest (zero-based) of all deviations: binary search for how
+    //  many of the k+1 smallest come from the lower sequence
+    MT kthDeviation(std::size_t k, std::size_t below, MT median) const {
+      const std::size_t nl = below, nu = scoresBuf_.size() - below;
+      std::size_t lo = (k + 1 > nu) ? k + 1 - nu : 0, hi = std::min(k + 1, nl);
+      while ( true ) {
+        const std::size_t i = lo + (hi - lo) / 2, j = k + 1 - i;
+        if ( i > 0 && j < nu && lower(below, median, i - 1) > upper(below, median, j) )
+          hi = i - 1;
+        else if ( j > 0 && i < nl && upper(below, median, j - 1) > lower(below, median, i) )
+          lo = i + 1;
+        else if ( i == 0 )
+          return upper(below, median, j - 1);
+        else if ( j == 0 )
+          return lower(below, median, i - 1);
+        else
+          return std::max(lower(below, median, i - 1), upper(below, median, j - 1));
+      } // while
+    }
+
     ProcessType pt_;
     const double mult_;
+    ScoreTypeContainer scoresBuf_;
   };
 
 } // namespace Visitors
@@ -0,0 +1,92 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 05:05:21 UTC 2026
+*/
+
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef CLASS_WINDOW_MONOTONIC_EXTREME_VISITOR_H
+#define CLASS_WINDOW_MONOTONIC_EXTREME_VISITOR_H
+
+#include "algorithm/visitors/numerical/ExtremeVisitor.hpp"
+#include "data/measurement/NaN.hpp"
+#include "utility/RingBuffer.hpp"
+
+namespace Visitors {
+
+  /*
+    Same results as Extreme<> with OnTies = DoNothing, but only valid when
+     items are removed in the order they were added -- true of every
+     Visitors::Visitor under WindowSweep::sweep(), which only ever pops the
+     front of its window.  The deque holds, front to back, each item that
+     no later-added item beats under CompType; front() is the extreme.
+     Amortized O(1) per Add()/Delete() versus O(log n) for the std::set<>.
+    Items that tie under CompType are all kept, and the earliest of them
+     is reported, so the 'Stable' orderings report the first element
+     observed for as long as it remains in the window.
+  */
+  template <
+            typename Process,
+            typename BaseVisitor,
+            typename CompType = Ordering::CompValueThenAddressLesser<
+                                                                     typename BaseVisitor::mapping_type,
+                                                                     typename BaseVisitor::mapping_type
+                                                                    >
+           >
+  struct MonotonicExtreme : BaseVisitor {
+
+    typedef BaseVisitor BaseClass;
+    typedef Process ProcessType;
+    typedef typename BaseVisitor::RefType RefType;
+    typedef typename BaseVisitor::MapType MapType;
+
+    explicit MonotonicExtreme(const ProcessType& pt = ProcessType()) : pt_(pt) { /* */ }
+
+    inline void Add(MapType* bt) {
+      while ( !m_.empty() && comp_(bt, m_.back()) )
+        m_.pop_back();
+      m_.push_back(bt);
+    }
+
+    inline void Delete(MapType* bt) {
+      if ( !m_.empty() && m_.front() == bt )
+        m_.pop_front();
+    }
+
+    void DoneReference() {
+      static const Signal::NaN nan = Signal::NaN();
+      if ( !m_.empty() )
+        pt_.operator()(m_.front());
+      else
+        pt_.operator()(nan);
+    }
+
+    virtual ~MonotonicExtreme() { /* */ }
+
+  protected:
+    ProcessType pt_;
+    CompType comp_;
+    Ext::RingBuffer<MapType*> m_;
+  };
+
+} // namespace Visitors
+
+
+#endif // CLASS_WINDOW_MONOTONIC_EXTREME_VISITOR_H
@@ -72,17 +72,20 @@ namespace Visitors {
       if ( kthPosDown > 0 ) // make zero-based
         --kthPosDown;
 
-      if ( size > 1 ) {
+      if ( BaseClass::hasNan() )
+        pt_.operator()(static_cast<MT>(**BaseClass::scoresBuf_.rbegin()));
+      else if ( size > 1 ) {
+        typename BaseClass::ScoreTypeContainer::iterator next = BaseClass::currentMarker_;
+        if ( ++next == BaseClass::scoresBuf_.end() ) // kth == 1
+          next = BaseClass::currentMarker_;
         if ( kthPosUp == kthPosDown ) { // a true integer; take average of two adjacent integers
           MT one = **BaseClass::currentMarker_;
-          typename BaseClass::ScoreTypeContainer::iterator next = BaseClass::currentMarker_;
-          MT two = **++next;
+          MT two = **next;
           pt_.operator()((one + two)/2.0);
         } else if ( BaseClass::currentAtPos_ == kthPosUp ) {
           pt_.operator()(static_cast<MT>(**BaseClass::currentMarker_));
         } else { // BaseClass::currentAtPos_ == kthPosDown; round up to kthPosUp per wikipedia
-          typename BaseClass::ScoreTypeContainer::iterator next = BaseClass::currentMarker_;
-          pt_.operator()(static_cast<MT>(**++next));
+          pt_.operator()(static_cast<MT>(**next));
         }
       } else if ( 1 == size ) {
         pt_.operator()(static_cast<MT>(**BaseClass::currentMarker_));
@@ -98,10 +101,6 @@ namespace Visitors {
     virtual ~RollingKthAverage()
       { /* */ }
 
-  protected:
-    typedef Ordering::CompValueThenAddressLesser<MapType, MapType> Comp;
-    typedef std::set<PtrType, Comp> ScoreTypeContainer;
-
   protected:
     ProcessType pt_;
   };
@@ -113,7 +113,9 @@ namespace Visitors {
         --currentAtPos_;
       } // while decrementing
 
-      if ( size )
+      if ( hasNan() )
+        pt_.operator()(static_cast<MT>(**scoresBuf_.rbegin()));
+      else if ( size )
         pt_.operator()(static_cast<MT>(**currentMarker_));
       else {
         static const Signal::NaN nan = Signal::NaN();
@@ -128,9 +130,15 @@ namespace Visitors {
       { /* */ }
 
   protected:
-    typedef Ordering::CompValueThenAddressLesser<MapType, MapType> Comp;
+    typedef typename Signal::SelectMeasure<MapType>::MeasureType MeasureType;
+    typedef Ordering::CompNumberThenAddressLesser<MapType, MeasureType> Comp; // ties independent of addresses
     typedef std::set<PtrType, Comp> ScoreTypeContainer;
 
+    // Comp sorts any nan last; a nan in the window is reported, as --mean would
+    inline bool hasNan() const {
+      return !scoresBuf_.empty() && std::isnan(static_cast<MeasureType>(**scoresBuf_.rbegin()));
+    }
+
   protected:
     const double kthValue_;
     std::size_t currentAtPos_;
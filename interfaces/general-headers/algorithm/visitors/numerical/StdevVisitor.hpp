@@ -25,8 +25,10 @@
 #define STDEVVISITOR_HPP
 
 #include <cmath>
+#include <memory>
 
 #include "data/measurement/NaN.hpp"
+#include "data/measurement/RunningMoments.hpp"
 #include "data/measurement/SelectMeasureType.hpp"
 
 namespace Visitors {
@@ -42,42 +44,40 @@ namespace Visitors {
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
     typedef typename Signal::SelectMeasure<MapType>::MeasureType MT;
+    typedef Signal::RunningMoments<MT> MomentsType;
 
-    explicit StdDev(const ProcessType& pt = ProcessType())
-        : pt_(pt), sum_(0), squareSum_(0), count_(0)
+    explicit StdDev(const ProcessType& pt = ProcessType(),
+                    const typename MomentsType::Shared& m = typename MomentsType::Shared())
+        : pt_(pt), m_(m ? m : std::make_shared<MomentsType>()), owner_(m_->claim())
       { /* */ }
 
-    inline void Add(MapType* bt) {
-      sum_ += *bt; 
-      squareSum_ += (*bt * *bt);
-      count_++;
-    }
+    inline void Add(MapType* bt)
+      { if ( owner_ ) m_->add(*bt); }
 
-    inline void Delete(MapType* bt) {
-      sum_ -= *bt; 
-      squareSum_ -= (*bt * *bt);
-      count_--;
-    }
+    inline void Delete(MapType* bt)
+      { if ( owner_ ) m_->remove(*bt); }
 
     inline void DoneReference() {
       static const Signal::NaN nan = Signal::NaN();
-      if ( count_ <= 1 )
+      if ( m_->count() <= 1 )
         pt_.operator()(nan);
       else {
-        MT numer = (count_ * squareSum_) - (sum_ * sum_);
-        MT denom = (count_ * (count_ - 1));
-        MT val = std::sqrt(numer / denom);
+        MT val = std::sqrt(m_->variance());
         pt_.operator()(val);
       }
     }
 
+    inline void End() {
+      if ( owner_ )
+        m_->reset();
+    }
+
     virtual ~StdDev() { /* */ }
 
   protected:
     ProcessType pt_;
-    MT sum_;
-    MT squareSum_;
-    long count_;
+    typename MomentsType::Shared m_; // may be shared with other moment visitors
+    const bool owner_;
   };
 
 } // namespace Visitors
@@ -24,8 +24,11 @@
 #ifndef CLASS_WINDOW_SUM_VISITOR_H
 #define CLASS_WINDOW_SUM_VISITOR_H
 
-#include "data/measurement/SelectMeasureType.hpp"
+#include <memory>
+
 #include "data/measurement/NaN.hpp"
+#include "data/measurement/RunningMoments.hpp"
+#include "data/measurement/SelectMeasureType.hpp"
 
 namespace Visitors {
 
@@ -39,32 +42,39 @@ namespace Visitors {
     typedef Process ProcessType;
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
+    typedef typename Signal::SelectMeasure<MapType>::MeasureType MT;
+    typedef Signal::RunningMoments<MT> MomentsType;
 
-    explicit Sum(const ProcessType& pt = ProcessType())
-        : pt_(pt), sum_(0), counter_(0)
+    explicit Sum(const ProcessType& pt = ProcessType(),
+                 const typename MomentsType::Shared& m = typename MomentsType::Shared())
+        : pt_(pt), m_(m ? m : std::make_shared<MomentsType>()), owner_(m_->claim())
       { /* */ }
 
     inline void Add(MapType* bt)
-      { sum_ += *bt; ++counter_; }
+      { if ( owner_ ) m_->add(*bt); }
 
     inline void Delete(MapType* bt)
-      { sum_ -= *bt; --counter_; }
+      { if ( owner_ ) m_->remove(*bt); }
 
     inline void DoneReference() {
       static const Signal::NaN nan = Signal::NaN();
-      if ( 0 < counter_ )
-        pt_.operator()(sum_);
+      if ( 0 < m_->count() )
+        pt_.operator()(m_->sum());
       else
         pt_.operator()(nan);
     }
 
-    virtual ~Sum()
-      { /* */ }
+    inline void End() {
+      if ( owner_ )
+        m_->reset();
+    }
+
+    virtual ~Sum() { /* */ }
 
   protected:
     ProcessType pt_;
-    typename Signal::SelectMeasure<MapType>::MeasureType sum_;
-    int counter_;
+    typename MomentsType::Shared m_; // may be shared with other moment visitors
+    const bool owner_;
   };
 
 } // namespace Visitors
@@ -24,6 +24,7 @@
 #ifndef TMEANS_VISITOR_HPP
 #define TMEANS_VISITOR_HPP
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
@@ -31,6 +32,7 @@
 #include <string>
 
 #include "data/measurement/NaN.hpp"
+#include "data/measurement/RunningMoments.hpp"
 #include "data/measurement/SelectMeasureType.hpp"
 #include "utility/Assertion.hpp"
 #include "utility/Exception.hpp"
@@ -50,15 +52,28 @@ namespace Visitors {
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
     typedef MapType* PtrType;
-    typedef Ordering::CompValueThenAddressLesser<MapType, MapType> Comp;
-    typedef std::set<PtrType, Comp> ScoreTypeContainer;
     typedef typename Signal::SelectMeasure<MapType>::MeasureType MT;
+    typedef Ordering::CompNumberThenAddressLesser<MapType, MT> Comp; // ties independent of addresses
+    typedef std::set<PtrType, Comp> ScoreTypeContainer;
+
+    // markers sweep scores in and out of their sums; peak() is the largest
+    //  magnitude swept through since reset() and bounds the rounding left behind
+    struct SumType {
+      SumType() : peak_(0) { /* */ }
+      inline void add(MT x) { sum_.add(x); peak_ = std::max(peak_, static_cast<MT>(std::fabs(x))); }
+      inline MT value() const { return sum_.value(); }
+      inline MT peak() const { return peak_; }
+      inline void reset() { sum_.reset(); peak_ = 0; }
+    private:
+      Signal::NeumaierSum<MT> sum_;
+      MT peak_;
+    };
 
     //==============
     // Construction
     //==============
     explicit TrimmedMean(double lowerKth=0.2, double upperKth = 0.8, const ProcessType& pt = ProcessType())
-        : lowerKth_(lowerKth), upperKth_(upperKth), lowerSum_(0), upperSum_(0), currentAtPosLower_(0),
+        : lowerKth_(lowerKth), upperKth_(upperKth), currentAtPosLower_(0),
           currentAtPosUpper_(0), doKth_(false), symmetric_(false), pt_(pt) {
       currentMarkerLower_ = scoresBuf_.end(), currentMarkerUpper_ = scoresBuf_.end();
       Ext::Assert<ExceptionType>(lowerKth_ >= 0 && lowerKth_ <= 1, "Expect 0 <= lowerKth <= 1");
@@ -130,17 +145,23 @@ namespace Visitors {
       if ( kthPosHigh > 0 )
         --kthPosHigh; // make zero-based
 
+      // Comp sorts any nan last; a nan in the window is reported, as --mean would.  The
+      //  markers still move, but their sums are left to be rebuilt once it is gone.
+      const bool hasNan = std::isnan(static_cast<MT>(**scoresBuf_.rbegin()));
       if ( !doKth_ && doLow )
-        doneRef(currentMarkerLower_, currentAtPosLower_, lowerSum_, kthPosLow);
-      doneRef(currentMarkerUpper_, currentAtPosUpper_, upperSum_, kthPosHigh);
+        doneRef(currentMarkerLower_, currentAtPosLower_, lowerSum_, kthPosLow, hasNan);
+      doneRef(currentMarkerUpper_, currentAtPosUpper_, upperSum_, kthPosHigh, hasNan);
+      const std::size_t atLow = (!doKth_ && doLow) ? currentAtPosLower_ : 0; // else lower marker unused, maybe stale
 
       // Spit results
-      if ( doKth_ || currentAtPosUpper_ == currentAtPosLower_ )
+      if ( hasNan )
+        pt_.operator()(static_cast<MT>(**scoresBuf_.rbegin()));
+      else if ( doKth_ || currentAtPosUpper_ == atLow )
         pt_.operator()(*currentMarkerUpper_); // single element related to kth - Bob T. thinks this is best
       else if ( doLow )
-        pt_.operator()((upperSum_ - lowerSum_)/(currentAtPosUpper_ - currentAtPosLower_));
+        pt_.operator()((upperSum_.value() - lowerSum_.value())/(currentAtPosUpper_ - currentAtPosLower_));
        else
-         pt_.operator()(upperSum_ / (currentAtPosUpper_ + 1));
+         pt_.operator()(upperSum_.value() / (currentAtPosUpper_ + 1));
     }
 
     //===========
@@ -151,58 +172,72 @@ namespace Visitors {
 
 
   protected:
-    inline void add(PtrType ptr, typename ScoreTypeContainer::iterator& marker, std::size_t& pos, MT& sum) {
+    inline void add(PtrType ptr, typename ScoreTypeContainer::iterator& marker, std::size_t& pos, SumType& sum) {
       static Comp comp;
       if ( marker == scoresBuf_.end() ) {
         marker = scoresBuf_.begin();
         pos = 0;
-        sum = *ptr;
+        sum.reset();
+        sum.add(static_cast<MT>(*ptr));
       } else if ( comp(ptr, *marker) ) { // ptr < marker
         ++pos;
-        sum += *ptr;
+        sum.add(static_cast<MT>(*ptr));
       }
     }
 
-    inline void remove(PtrType ptr, typename ScoreTypeContainer::iterator& marker, std::size_t& pos, MT& sum) {
+    inline void remove(PtrType ptr, typename ScoreTypeContainer::iterator& marker, std::size_t& pos, SumType& sum) {
       // keep in mind that you cannot be here if there is <= 1 element
       //  in the scoresBuf_ containers.
       static Comp comp;
       if ( comp(ptr, *marker) ) { // toRemove < marker
         --pos;
-        sum -= *ptr;
+        sum.add(-static_cast<MT>(*ptr));
       }
       else if ( ptr == *marker ) { // removing marker
-        sum -= *ptr;
+        sum.add(-static_cast<MT>(*ptr));
         if ( marker != scoresBuf_.begin() ) {
           --marker;
           --pos;
         } else {
           if ( ++marker != scoresBuf_.end() )
-            sum += **marker;
+            sum.add(static_cast<MT>(**marker));
           // pos remains the same
         }
       }
     }
 
-    inline void doneRef(typename ScoreTypeContainer::iterator& marker, std::size_t& pos, MT& sum, std::size_t newPos) {
+    inline void doneRef(typename ScoreTypeContainer::iterator& marker, std::size_t& pos, SumType& sum, std::size_t newPos, bool hasNan) {
 
       // Increment markers as needed
       while ( newPos > pos ) {
-        sum += **++marker;
+        sum.add(static_cast<MT>(**++marker));
         ++pos;
       } // while
 
       // Decrement markers as needed
       while ( newPos < pos ) {
-        sum -= **marker--;
+        sum.add(-static_cast<MT>(**marker--));
         --pos;
       } // while
+
+      // once an inf or nan has passed through, the sum is stuck at inf or nan.  Once a
+      //  score far larger than any now summed has passed through, the rounding it left
+      //  may swamp what is summed.  Either way, start over.  The summed range is sorted,
+      //  so its largest magnitude is at one end or the other.
+      static const MT maxPeakRatio = 1024;
+      const MT scale = std::max(std::fabs(static_cast<MT>(**scoresBuf_.begin())), std::fabs(static_cast<MT>(**marker)));
+      if ( !hasNan && (!std::isfinite(sum.value()) || sum.peak() > maxPeakRatio * scale) ) {
+        sum.reset();
+        for ( typename ScoreTypeContainer::iterator i = scoresBuf_.begin(); i != marker; ++i )
+          sum.add(static_cast<MT>(**i));
+        sum.add(static_cast<MT>(**marker));
+      }
     }
 
   protected:
     const double lowerKth_;
     const double upperKth_;
-    MT lowerSum_, upperSum_;
+    SumType lowerSum_, upperSum_;
     std::size_t currentAtPosLower_, currentAtPosUpper_;
     bool doKth_, symmetric_;
     ProcessType pt_;
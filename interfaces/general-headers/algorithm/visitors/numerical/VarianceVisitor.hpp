@@ -24,7 +24,10 @@
 #ifndef VARIANCEVISITOR_HPP
 #define VARIANCEVISITOR_HPP
 
+#include <memory>
+
 #include "data/measurement/NaN.hpp"
+#include "data/measurement/RunningMoments.hpp"
 #include "data/measurement/SelectMeasureType.hpp"
 
 namespace Visitors {
@@ -40,41 +43,38 @@ namespace Visitors {
     typedef typename BaseClass::RefType RefType;
     typedef typename BaseClass::MapType MapType;
     typedef typename Signal::SelectMeasure<MapType>::MeasureType MT;
+    typedef Signal::RunningMoments<MT> MomentsType;
 
-    explicit Variance(const ProcessType& pt = ProcessType())
-       : pt_(pt), sum_(0), squareSum_(0), count_(0)
+    explicit Variance(const ProcessType& pt = ProcessType(),
+                      const typename MomentsType::Shared& m = typename MomentsType::Shared())
+        : pt_(pt), m_(m ? m : std::make_shared<MomentsType>()), owner_(m_->claim())
       { /* */ }
 
-    inline void Add(MapType* bt) {
-      sum_ += *bt; 
-      squareSum_ += (*bt * *bt);
-      count_++;
-    }
+    inline void Add(MapType* bt)
+      { if ( owner_ ) m_->add(*bt); }
 
-    inline void Delete(MapType* bt) {
-      sum_ -= *bt; 
-      squareSum_ -= (*bt * *bt);
-      count_--;
-    }
+    inline void Delete(MapType* bt)
+      { if ( owner_ ) m_->remove(*bt); }
 
     inline void DoneReference() {
       static const Signal::NaN nan = Signal::NaN();
-      if ( count_ <= 1 )
+      if ( m_->count() <= 1 )
         pt_.operator()(nan);
-      else {
-        MT numer = (count_ * squareSum_) - (sum_ * sum_);
-        MT denom = (count_ * (count_ - 1));
-        pt_.operator()(numer / denom);
-      }
+      else
+        pt_.operator()(m_->variance());
+    }
+
+    inline void End() {
+      if ( owner_ )
+        m_->reset();
     }
 
     virtual ~Variance() { /* */ }
 
   protected:
     ProcessType pt_;
-    MT sum_;
-    MT squareSum_;
-    long count_;
+    typename MomentsType::Shared m_; // may be shared with other moment visitors
+    const bool owner_;
   };
 
 } // namespace Visitors
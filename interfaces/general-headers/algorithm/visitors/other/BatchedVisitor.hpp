@@ -0,0 +1,58 @@
+/*
+  FILE: BatchedVisitor.hpp
+  AUTHOR: agent
+  CREATE DATE: Sat Oct 17 03:43:02 UTC 2026
+  PROJECT: utility
+  ID: $Id$
+*/
+
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef _BATCHED_VISITOR_HPP
+#define _BATCHED_VISITOR_HPP
+
+#include <cstddef>
+
+namespace Visitors {
+
+  // Batched<V> is a V whose AddBatch()/DeleteBatch() walk a run of items
+  //  with direct, inlinable calls to V::Add()/V::Delete().  Under a
+  //  MultiVisitor, that is one virtual call per visitor per run of items
+  //  instead of one per item.
+  template <typename VisitorType>
+  struct Batched final : VisitorType {
+    typedef typename VisitorType::MapType MapType;
+
+    using VisitorType::VisitorType;
+
+    void AddBatch(MapType* const* u, std::size_t n) override {
+      for ( std::size_t i = 0; i < n; ++i )
+        VisitorType::Add(u[i]);
+    }
+
+    void DeleteBatch(MapType* const* u, std::size_t n) override {
+      for ( std::size_t i = 0; i < n; ++i )
+        VisitorType::Delete(u[i]);
+    }
+  };
+
+} // namespace Visitors
+
+#endif // _BATCHED_VISITOR_HPP
@@ -30,6 +30,7 @@
 #define MULTIVISITOR_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -81,6 +82,19 @@ namespace Visitors {
       std::for_each(t_.begin(), t_.end(), std::bind(std::mem_fn(memberFuncPtr), std::placeholders::_1, u));
       --cnt_;
     }
+
+    // one virtual call per visitor per run, rather than per item
+    void AddBatch(MapType* const* u, std::size_t n) {
+      for ( cGtI gi = t_.begin(); gi != t_.end(); ++gi )
+        (*gi)->AddBatch(u, n);
+      cnt_ += n;
+    }
+
+    void DeleteBatch(MapType* const* u, std::size_t n) {
+      for ( cGtI gi = t_.begin(); gi != t_.end(); ++gi )
+        (*gi)->DeleteBatch(u, n);
+      cnt_ -= n;
+    }
     
     void DoneReference() {
       if ( !pAll_ && cnt_ == 0 )
@@ -25,31 +25,43 @@
 #define SPECIAL_STARCH_ALLOCATE_NEW_ITERATOR_CHR_SPECIFIC_POOL_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
 #include <type_traits>
 
 #include <sys/stat.h>
 
+#include "utility/ConcurrentPooledMemory.hpp"
 #include "utility/PooledMemory.hpp"
 
 #include "algorithm/bed/FindBedRange.hpp"
 #include "algorithm/visitors/helpers/ProcessVisitorRow.hpp"
 #include "data/bed/Bed.hpp"
+#include "data/bed/BedTokenizer.hpp"
 #include "data/starch/starchApi.hpp"
 #include "suite/BEDOPS.Constants.hpp"
 #include "utility/FPWrap.hpp"
+#include "utility/MappedFile.hpp"
+#include "utility/SPSCQueue.hpp"
 
 namespace Bed {
 
-  template <class BedType, std::size_t SZ=Bed::CHUNKSZ>
+  // PoolType: anything with PooledMemory's construct()/release(), such as
+  //  Ext::ConcurrentPooledMemory when records are freed on another thread
+  template <class BedType, std::size_t SZ=Bed::CHUNKSZ,
+            class PoolType=Ext::PooledMemory<typename std::remove_pointer<BedType>::type, SZ>>
   class allocate_iterator_starch_bed;
 
-  template <class BedType, std::size_t SZ>
-  class allocate_iterator_starch_bed<BedType*, SZ> {
+  template <class BedType, std::size_t SZ, class PoolType>
+  class allocate_iterator_starch_bed<BedType*, SZ, PoolType> {
 
   public:
     typedef std::forward_iterator_tag iterator_category;
@@ -57,12 +69,13 @@ namespace Bed {
     typedef std::ptrdiff_t            difference_type;
     typedef BedType**                 pointer;
     typedef BedType*&                 reference;
+    typedef PoolType                  pool_type;
 
     allocate_iterator_starch_bed() : fp_(NULL), _M_ok(false), _M_value(0), is_starch_(false),
                                      all_(false), archive_(NULL), pool_(NULL) { chr_[0] = '\0'; }
 
     template <typename ErrorType>
-    allocate_iterator_starch_bed(Ext::FPWrap<ErrorType>& fp, Ext::PooledMemory<BedType, SZ>& p,
+    allocate_iterator_starch_bed(Ext::FPWrap<ErrorType>& fp, PoolType& p,
                                       const std::string& chr = "all") /* this ASSUMES fp is open and meaningful */
       : fp_(fp), _M_ok(fp_ && !std::feof(fp_)), _M_value(0),
         is_starch_(false),
@@ -87,6 +100,11 @@ namespace Bed {
         is_namedpipe = (S_ISFIFO(st.st_mode) != 0);
       }
       is_starch_ = !is_namedpipe && _M_ok && (fp_ != stdin) && starch::Starch::isStarch(fp_);
+      if ( !is_starch_ && !is_namedpipe && fp_ != stdin ) { // regular BED file: parse it in place
+        map_ = std::make_shared<Ext::MappedFile>(fp_);
+        if ( !map_->valid() )
+          map_.reset();
+      }
 
       if ( (fp_ == stdin || is_namedpipe) && !all_ ) { // BED, chrom-specific, using stdin
         // stream through until we find what we want
@@ -116,6 +134,16 @@ namespace Bed {
                    (archive_->getArchiveRecordIter() != NULL) &&
                    !archive_->isEOF());
         }
+      } else if ( map_ && !all_ ) { // mapped BED, chromosome-specific
+        _M_ok = seek_chrom() && next_mapped() && (0 == std::strcmp(_M_value->chrom(), chr_));
+        if ( !_M_ok ) {
+          _M_value = static_cast<BedType*>(0);
+          fp_ = NULL;
+        }
+      } else if ( map_ ) { // mapped BED, process everything
+        _M_ok = next_mapped();
+        if ( !_M_ok )
+          fp_ = NULL;
       } else if ( !all_ ) { // BED, chromosome-specific
         // position fp_ to start of correct chromosome
         std::fseek(fp_, 0, SEEK_END);  // apparently dangerous on some platforms in binary mode -> padded nulls;
@@ -172,41 +200,28 @@ namespace Bed {
       }
     }
   
+    // readAhead: build records on a thread of its own, ahead of the caller.  Taken
+    //  up only with a pool that lets the caller release what that thread builds.
+    template <typename ErrorType>
+    allocate_iterator_starch_bed(Ext::FPWrap<ErrorType>& fp, PoolType& p, const std::string& chr, bool readAhead)
+      : allocate_iterator_starch_bed(fp, p, chr) {
+      if ( readAhead && _M_ok )
+        read_ahead(Ext::is_concurrent_pool<PoolType>());
+    }
+
     reference operator*() { return _M_value; }
     pointer operator->() { return &(operator*()); }
   
     allocate_iterator_starch_bed& operator++() { 
-      if ( _M_ok ) {
-        if ( !is_starch_ ) {
-          _M_value = pool_->construct(fp_);
-          _M_ok = !std::feof(fp_) && (all_ || 0 == std::strcmp(_M_value->chrom(), chr_));
-          // very small leak in event that !all_ and _M_value->chrom() is not chr_
-          //   too expensive to check
-        } else {
-          _M_value = get_starch();
-          _M_ok = (static_cast<bool>(_M_value) && 
-                   (archive_->getArchiveRecordIter() != NULL) &&
-                   !archive_->isEOF());
-        }
-      }
+      if ( _M_ok )
+        advance();
       return *this;
     }
   
     allocate_iterator_starch_bed operator++(int)  {
       auto __tmp = *this;
-      if ( _M_ok ) {
-        if ( !is_starch_ ) {
-          _M_value = pool_->construct(fp_);
-          _M_ok = !std::feof(fp_) && (all_ || 0 == std::strcmp(_M_value->chrom(), chr_));
-          // very small leak in event that !all_ and _M_value->chrom() is not chr_
-          //   too expensive to check
-        } else {
-          _M_value = get_starch();
-          _M_ok = (static_cast<bool>(_M_value) && 
-                   (archive_->getArchiveRecordIter() != NULL) &&
-                   !archive_->isEOF());
-        }
-      }
+      if ( _M_ok )
+        advance();
       return __tmp;
     }
   
@@ -223,11 +238,108 @@ namespace Bed {
       return true; // assumption for BED
     }
 
-    Ext::PooledMemory<BedType, SZ>& get_pool() { return *pool_; }
+    PoolType& get_pool() { return *pool_; }
 
   private:
+    struct Reader;
+
+    inline void advance() {
+      if ( reader_ ) {
+        _M_ok = reader_->next(_M_value);
+      } else if ( map_ ) {
+        _M_ok = next_mapped() && (all_ || 0 == std::strcmp(_M_value->chrom(), chr_));
+      } else if ( !is_starch_ ) {
+        _M_value = pool_->construct(fp_);
+        _M_ok = !std::feof(fp_) && (all_ || 0 == std::strcmp(_M_value->chrom(), chr_));
+        // very small leak in event that !all_ and _M_value->chrom() is not chr_
+        //   too expensive to check
+      } else {
+        _M_value = get_starch();
+        _M_ok = (static_cast<bool>(_M_value) && 
+                 (archive_->getArchiveRecordIter() != NULL) &&
+                 !archive_->isEOF());
+      }
+    }
+
+    inline void read_ahead(std::true_type) {
+      reader_ = std::make_shared<Reader>(*this);
+      reader_->start();
+    }
+
+    inline void read_ahead(std::false_type)
+      { /* records built on another thread could not go back to this pool */ }
+
+    // mapped BED: construct the next row straight from the mapping.  false once
+    //  no complete row is left, matching std::feof() after readline(FILE*).
+    inline bool next_mapped() {
+      char const* row;
+      do {
+        if ( !(row = map_->getline()) )
+          return false;
+      } while ( *Tokenize::skipws(row) == '\n' ); // blank, as readline(FILE*) skips
+      _M_value = construct(row, map_->pos(), std::is_constructible<BedType, char const*, char const*>());
+      return true;
+    }
+
+    // the row runs to just past its '\n'; types that only read text (Bed_minmem.hpp)
+    //  take it as they always did
+    inline BedType* construct(char const* row, char const* end, std::true_type) {
+      return pool_->construct(row, end);
+    }
+
+    inline BedType* construct(char const* row, char const*, std::false_type) {
+      return pool_->construct(row);
+    }
+
+    // strcmp(<first column of row>, chr_) < 0
+    inline bool chrom_before(char const* row) const {
+      char const* const end = map_->end();
+      char const* c = chr_;
+      while ( row != end && !Tokenize::isws(*row) && *c != '\0' && *row == *c )
+        ++row, ++c;
+      const unsigned char r = (row == end || Tokenize::isws(*row)) ? 0 : static_cast<unsigned char>(*row);
+      return r < static_cast<unsigned char>(*c);
+    }
+
+    // mapped BED: binary search on rows for the first one on chr_ or after it, the
+    //  pointer arithmetic version of find_bed_range() used for FILE*
+    inline bool seek_chrom() {
+      char const* lo = map_->pos(); // lo and hi always sit at the start of a row
+      char const* hi = map_->end();
+      while ( lo < hi ) {
+        char const* row = map_->line_start(lo + (hi - lo) / 2);
+        if ( chrom_before(row) ) {
+          char const* nl = static_cast<char const*>(std::memchr(row, '\n', static_cast<std::size_t>(hi - row)));
+          lo = nl ? nl + 1 : hi;
+        } else {
+          hi = row;
+        }
+      } // while
+      map_->pos(lo);
+      return lo != map_->end();
+    }
+
     inline BedType* get_starch() {
-      static std::string line;
+      return get_starch(std::is_constructible<BedType, char const*, const Bed::DecodedCoords&>());
+    }
+
+    // the archive hands over decoded coordinates, so there is no line of text to
+    //  print and scan back; only the columns past the 3rd are tokenized
+    inline BedType* get_starch(std::true_type) {
+      char const* chr;
+      char const* rest;
+      Bed::SignedCoordType start, stop;
+      if ( archive_ == NULL || !archive_->extractBEDElement(chr, start, stop, rest) )
+        return(0);
+      if ( chr == NULL ) // as from the empty line extractBEDLine() gives here
+        return(pool_->construct(""));
+      const Bed::DecodedCoords coords = { chr, std::strlen(chr), static_cast<Bed::CoordType>(start), static_cast<Bed::CoordType>(stop) };
+      return(pool_->construct(rest, coords));
+    }
+
+    // types that only read text (Bed_minmem.hpp)
+    inline BedType* get_starch(std::false_type) {
+      thread_local static std::string line;
       if ( archive_ == NULL || !archive_->extractBEDLine(line) )
         return(0);
       return(pool_->construct(line.c_str()));
@@ -241,20 +353,93 @@ namespace Bed {
     bool is_starch_;
     const bool all_;
     starch::Starch* archive_;
-    Ext::PooledMemory<BedType, SZ>* pool_;
+    PoolType* pool_;
+    std::shared_ptr<Ext::MappedFile> map_; // shared: copies advance together, as through fp_
+    std::shared_ptr<Reader> reader_; // likewise
+  };
+
+  //=========
+  // Reader : runs a copy of an allocate_iterator_starch_bed on a thread of its
+  //           own and passes each record through a bounded queue.  The copy
+  //           starts where the original stands and is the only one to touch
+  //           the input from then on.  An exception on that thread is thrown
+  //           again to the caller in place of the end of input.
+  //=========
+  template <class BedType, std::size_t SZ, class PoolType>
+  struct allocate_iterator_starch_bed<BedType*, SZ, PoolType>::Reader {
+    explicit Reader(const allocate_iterator_starch_bed& from)
+      : it_(from), stop_(false) { }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    ~Reader() {
+      stop_.store(true, std::memory_order_relaxed);
+      if ( thread_.joinable() )
+        thread_.join();
+      BedType* b;
+      while ( q_.pop(b) ) { // read but never asked for
+        if ( b )
+          it_.pool_->release(b);
+      } // while
+    }
+
+    inline void start() { thread_ = std::thread(&Reader::run, this); }
+
+    // false at the end of input
+    inline bool next(BedType*& b) {
+      Ext::Backoff w;
+      while ( !q_.pop(b) )
+        w.wait();
+      if ( b )
+        return true;
+      if ( error_ )
+        std::rethrow_exception(error_);
+      return false;
+    }
+
+  private:
+    void run() {
+      try {
+        do {
+          it_.advance();
+        } while ( put(it_._M_ok ? it_._M_value : nullptr) && it_._M_ok );
+        return;
+      } catch(...) {
+        error_ = std::current_exception();
+      }
+      put(nullptr);
+    }
+
+    // false if told to stop while the queue is full
+    inline bool put(BedType* b) {
+      Ext::Backoff w;
+      while ( !q_.push(b) ) {
+        if ( stop_.load(std::memory_order_relaxed) )
+          return false;
+        w.wait();
+      } // while
+      return true;
+    }
+
+    allocate_iterator_starch_bed it_;
+    std::atomic<bool> stop_;
+    std::exception_ptr error_;
+    Ext::SPSCQueue<BedType*> q_;
+    std::thread thread_;
   };
   
-  template <class BedType, std::size_t sz>
+  template <class BedType, std::size_t sz, class PoolType>
   inline bool 
-  operator==(const allocate_iterator_starch_bed<BedType, sz>& __x,
-             const allocate_iterator_starch_bed<BedType, sz>& __y) {
+  operator==(const allocate_iterator_starch_bed<BedType, sz, PoolType>& __x,
+             const allocate_iterator_starch_bed<BedType, sz, PoolType>& __y) {
     return __x._M_equal(__y);
   }
   
-  template <class BedType, std::size_t sz>
+  template <class BedType, std::size_t sz, class PoolType>
   inline bool 
-  operator!=(const allocate_iterator_starch_bed<BedType, sz>& __x,
-             const allocate_iterator_starch_bed<BedType, sz>& __y) {
+  operator!=(const allocate_iterator_starch_bed<BedType, sz, PoolType>& __x,
+             const allocate_iterator_starch_bed<BedType, sz, PoolType>& __y) {
     return !__x._M_equal(__y);
   }
 
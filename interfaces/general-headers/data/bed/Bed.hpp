@@ -24,6 +24,7 @@
 #ifndef BED_NONEW_HPP
 #define BED_NONEW_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -32,8 +33,13 @@
 #include <string>
 #include <type_traits>
 
+#include "data/bed/BedTokenizer.hpp"
+#include "data/bed/ChromTable.hpp"
 #include "suite/BEDOPS.Constants.hpp"
+#include "utility/ByteArena.hpp"
+#include "utility/FastFormats.hpp"
 #include "utility/Formats.hpp"
+#include "utility/OutputBuffer.hpp"
 
 /*
   sjn
@@ -46,6 +52,9 @@
     Instead, use all tools wisely.
   There is no automated way (that I know of) to prevent improper base pointer to derived class.  Using these
     in that way leads to memory leaks (and is the reason for that rule of thumb).
+  Records are sized by what they hold, not by the MAX*SIZE limits: a chromosome is a pointer into
+    ChromTable, and the id and rest columns are Ext::ArenaStrings that copies share.  The limits still
+    cut each column where the fixed char arrays that these replaced used to.
 */
 
 namespace Bed {
@@ -54,6 +63,18 @@ namespace Bed {
   constexpr CoordType MAXIDSIZE = TOKEN_ID_MAX_LENGTH;
   constexpr CoordType MAXRESTSIZE = TOKEN_REST_MAX_LENGTH;
 
+  // The first 3 columns of a row, decoded by something other than a text parser
+  //  (a Starch archive, or bed_check_iterator's validation pass).  Each type's
+  //  readline(rest, &coords, end) and (rest, coords, end) constructor read the rest
+  //  of the row from rest, which starts where the end coordinate would stop on the
+  //  text line: at the tab ahead of the 4th column.  end is as for readline().
+  struct DecodedCoords {
+    char const* chrom;
+    std::size_t chromsz;
+    CoordType start;
+    CoordType end;
+  };
+
 
   /*****************************************/
   /* ChromInfo Classes                     */
@@ -64,22 +85,24 @@ namespace Bed {
   struct ChromInfo {
     static constexpr bool IsNonStatic = isNonStatic;
 
-    ChromInfo() { chrom_[0] = '\0'; }
-    ChromInfo(const ChromInfo& c) { std::strcpy(chrom_, c.chrom_); }
-    explicit ChromInfo(char const* c)  { std::strcpy(chrom_, c); }
+    ChromInfo() { chrom_ = ChromTable::empty(chromOrd_); }
+    explicit ChromInfo(char const* c) { chrom_ = ChromTable::intern(c, std::strlen(c), chromOrd_); }
+    /* Desire default-shallow copy-construction & copy-assignment */
 
     // Properties
     inline char const* chrom() const { return chrom_; }
-    inline void chrom(char const* chrom) { std::strcpy(chrom_, chrom); }
+    inline void chrom(char const* chrom) { chrom_ = ChromTable::intern(chrom, std::strlen(chrom), chromOrd_); }
+    inline void chrom(char const* chrom, std::size_t n) { chrom_ = ChromTable::intern(chrom, n, chromOrd_); }
+    inline ChromTable::Ordinal chromOrdinal() const { return chromOrd_; }
 
-    // Operators
-    ChromInfo& operator=(const ChromInfo& c) {
-      std::strcpy(chrom_, c.chrom_);
-      return *this;
-    }
+    // Comparison utilities
+    inline bool samechrom(const ChromInfo& a) const { return chrom_ == a.chrom_; }
 
   protected:
-    char chrom_[MAXCHROMSIZE+1];
+    inline void clear_chrom() { chrom_ = ChromTable::empty(chromOrd_); }
+
+    char const* chrom_;
+    ChromTable::Ordinal chromOrd_; // sorts as chrom_ does
   };
 
 
@@ -94,8 +117,14 @@ namespace Bed {
     // Properties
     char const* chrom() const { return chrom_; }
     void chrom(char const* chrom) { std::strcpy(chrom_, chrom); }
+    void chrom(char const* chrom, std::size_t n) { std::memcpy(chrom_, chrom, n); chrom_[n] = '\0'; }
+
+    // Comparison utilities
+    bool samechrom(const ChromInfo& a) const { return 0 == std::strcmp(chrom_, a.chrom_); }
 
   protected:
+    inline void clear_chrom() { chrom_[0] = '\0'; }
+
     static char chrom_[MAXCHROMSIZE+1];
   };
 
@@ -119,22 +148,28 @@ namespace Bed {
     BasicCoords(char const* chrom, CoordType start, CoordType end)
       : BaseClass(chrom), start_(start), end_(end) {}
     BasicCoords(const BasicCoords& c)
-      : BaseClass(c.chrom_), start_(c.start_), end_(c.end_) {}
+      : BaseClass(c), start_(c.start_), end_(c.end_) {}
     explicit BasicCoords(FILE* inF) : BaseClass()
       { this->readline(inF); }
     explicit BasicCoords(const std::string& inS) : BaseClass()
       { this->readline(inS); }
+    explicit BasicCoords(char const* inS) : BaseClass()
+      { this->readline(inS); }
+    BasicCoords(char const* inS, char const* end) : BaseClass()
+      { this->readline(inS, nullptr, end); }
+    BasicCoords(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+      { this->readline(rest, &coords, end); }
 
     // Properties
     inline CoordType length() const { return end_ - start_; }
     inline CoordType median() const { return start_ + ((end_ - start_) / 2); }
     inline CoordType distance(const BasicCoords& a) const {
-      if ( 0 == std::strcmp(chrom_, a.chrom_) )
+      if ( this->samechrom(a) )
         return start_ - a.start_;
       return std::numeric_limits<CoordType>::max();
     }
     inline SignedCoordType sepDistance(const BasicCoords& a) const {
-      if( 0 == std::strcmp(chrom_, a.chrom_) )
+      if ( this->samechrom(a) )
         return end_ - a.start_;
       return std::numeric_limits<CoordType>::max();
     }
@@ -145,7 +180,7 @@ namespace Bed {
 
     // Comparison utilities
     inline CoordType overlap(const BasicCoords& a) const {
-      if ( 0 != std::strcmp(chrom_, a.chrom_) )
+      if ( !this->samechrom(a) )
         return 0;
       if ( start_ >= a.start_ ) {
         if ( a.end_ > start_ ) {
@@ -195,38 +230,34 @@ namespace Bed {
     }
 
     // IO
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_);
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_);
     }
-    inline void println() const {
-      static const std::string heapFormat = (outFormatter() + "\n");
-      static char const* format = heapFormat.c_str();
-      std::printf(format, chrom_, start_, end_);
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_);
     }
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      *chrom_ = '\0';
-      int numScan = std::sscanf(inputLine.c_str(),
-                                format, chrom_,
-                                &start_, &end_);
-      return numScan;
+      return readline(inputLine.c_str());
+    }
+    // end, when given, is the end of inputLine's buffer (a mapped row's is past its
+    //  '\n').  Only types that keep the rest of the row scan that far and use it.
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      char const* p = inputLine;
+      return scan(p, coords);
     }
     inline int readline(FILE* inputFile) {
-      static std::string lclstatic = inFormatter();
-      static char const* format = lclstatic.c_str();
-      *chrom_ = '\0';
-      int numScan = std::fscanf(inputFile,
-                                format, chrom_,
-                                &start_, &end_);
-      std::fgetc(inputFile); // chomp newline
-      return numScan;
+      this->clear_chrom();
+      char const* p = Tokenize::line(inputFile);
+      return p ? scan(p) : EOF;
     }
 
     static const int NumFields = 3;
@@ -238,6 +269,27 @@ namespace Bed {
     CoordType start_;
     CoordType end_;
 
+    // same fields and return value as sscanf() with inFormatter(); leaves p after end_.
+    //  With coords, the first 3 columns come from there and p is left alone.
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr) {
+      if ( coords ) {
+        this->chrom(coords->chrom, std::min<std::size_t>(coords->chromsz, MAXCHROMSIZE));
+        start_ = coords->start;
+        end_ = coords->end;
+        return 3;
+      }
+      char const* tok;
+      std::size_t n;
+      if ( !Tokenize::token(p, tok, n) )
+        return EOF;
+      this->chrom(tok, std::min<std::size_t>(n, MAXCHROMSIZE));
+      if ( !Tokenize::coord(p, start_) )
+        return 1;
+      if ( !Tokenize::coord(p, end_) )
+        return 2;
+      return 3;
+    }
+
     static std::string outFormatter() {
       return(std::string("%s\t%" PRIu64 "\t%" PRIu64));
     }
@@ -253,61 +305,61 @@ namespace Bed {
   struct BasicCoords
     : public BasicCoords<IsNonStaticChrom, false> {
 
-    BasicCoords() : BaseClass() { fullrest_[0] = '\0'; }
+    BasicCoords() : BaseClass() { }
     BasicCoords(const BasicCoords& c)
-      : BaseClass(c)
-      { std::strcpy(fullrest_, c.fullrest_); }
+      : BaseClass(c), fullrest_(c.fullrest_) { }
     explicit BasicCoords(FILE* inF) : BaseClass()
       { this->readline(inF); }
     explicit BasicCoords(const std::string& inS) : BaseClass()
       { this->readline(inS); }
+    explicit BasicCoords(char const* inS) : BaseClass()
+      { this->readline(inS); }
+    BasicCoords(char const* inS, char const* end) : BaseClass()
+      { this->readline(inS, nullptr, end); }
+    BasicCoords(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+      { this->readline(rest, &coords, end); }
 
     // Properties
-    inline char const* full_rest() const { return fullrest_; }
+    inline char const* full_rest() const { return fullrest_.c_str(); }
 
     // Operators
     BasicCoords& operator=(const BasicCoords& c) {
       BaseClass::operator=(c);
-      std::strcpy(fullrest_, c.fullrest_);
+      fullrest_ = c.fullrest_;
       return *this;
     }
 
     // IO
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(fullrest_.c_str());
     }
-    inline void println() const {
-      static const std::string heapFormat = (outFormatter() + "\n");
-      static char const* format = heapFormat.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_)
-               + std::string(fullrest_); /* fullrest_ has a starting tab if applicable */
+               + std::string(fullrest_.c_str()); /* fullrest_ has a starting tab if applicable */
     }
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      chrom_[0] = '\0';
-      fullrest_[0] = '\0';
-      int numScan = std::sscanf(inputLine.c_str(), 
-                                format, chrom_, &start_,
-                                &end_, fullrest_);
-      return numScan;
+      return readline(inputLine.c_str(), nullptr, inputLine.c_str() + inputLine.size());
+    }
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      fullrest_.clear();
+      char const* p = inputLine;
+      return scan(p, coords, end);
     }
     inline int readline(FILE* inputFile) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      chrom_[0] = '\0';
-      fullrest_[0] = '\0';
-      int numScan = std::fscanf(inputFile, format,
-                                chrom_, &start_,
-                                &end_, fullrest_);
-      std::fgetc(inputFile); // chomp newline
-      return numScan;
+      this->clear_chrom();
+      fullrest_.clear();
+      char const* end;
+      char const* p = Tokenize::line(inputFile, end);
+      return p ? scan(p, nullptr, end) : EOF;
     }
 
     static const bool UseRest = true;
@@ -317,7 +369,17 @@ namespace Bed {
     using BaseClass::chrom_;
     using BaseClass::start_;
     using BaseClass::end_;
-    char fullrest_[MAXRESTSIZE + 1];
+    Ext::ArenaString fullrest_;
+
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      int numScan = BaseClass::scan(p, coords);
+      std::size_t n;
+      if ( numScan == 3 && (n = Tokenize::rest(p, end)) != 0 ) {
+        fullrest_.assign(p, std::min<std::size_t>(n, MAXRESTSIZE));
+        ++numScan;
+      }
+      return numScan;
+    }
 
     static std::string outFormatter() {
       return(std::string("%s\t%" PRIu64 "\t%" PRIu64 "%s"));
@@ -342,62 +404,64 @@ namespace Bed {
   struct Bed4<BasicCoords<IsNonStaticChrom, B3HasRest>, false> 
     : public BasicCoords<IsNonStaticChrom, false> {
 
-    Bed4() : BaseClass() { *id_ = '\0'; }
+    Bed4() : BaseClass() { }
     Bed4(char const* chrom, CoordType start, CoordType end, char const* id)
       : BaseClass(chrom, start, end)
-      { *id_ = '\0'; if ( id != nullptr ) std::strcpy(id_, id); }
+      { if ( id != nullptr ) id_.assign(id); }
     Bed4(const Bed4& c)
-      : BaseClass(c)
-      { *id_ = '\0'; std::strcpy(id_, c.id_); }
+      : BaseClass(c), id_(c.id_) { }
     explicit Bed4(FILE* inF) : BaseClass()
       { this->readline(inF); }
     explicit Bed4(const std::string& inS) : BaseClass()
       { this->readline(inS); }
+    explicit Bed4(char const* inS) : BaseClass()
+      { this->readline(inS); }
+    Bed4(char const* inS, char const* end) : BaseClass()
+      { this->readline(inS, nullptr, end); }
+    Bed4(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+      { this->readline(rest, &coords, end); }
 
     // IO
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      *chrom_ = '\0';
-      *id_ = '\0';
-      return std::sscanf(inputLine.c_str(), format,
-                         chrom_, &start_, &end_, id_);
+      return readline(inputLine.c_str());
+    }
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      id_.clear();
+      char const* p = inputLine;
+      return scan(p, coords);
     }
     inline int readline(FILE* inputFile) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      *chrom_ = '\0';
-      *id_ = '\0';
-      int numScanned = std::fscanf(inputFile, format,
-                                   chrom_, &start_, &end_, id_);
-      std::fgetc(inputFile); // read and discard newline
-      return numScanned;
+      this->clear_chrom();
+      id_.clear();
+      char const* p = Tokenize::line(inputFile);
+      return p ? scan(p) : EOF;
     }
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_, id_);
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_.c_str());
     }
-    inline void println() const {
-      static const std::string heapFormat = (outFormatter() + "\n");
-      static char const* format = heapFormat.c_str();
-      printf(format, chrom_, start_, end_, id_);
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
 
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_) + tab
-               + std::string(id_);
+               + std::string(id_.c_str());
     }
 
     // Properties
-    inline void id(char const* id) { *id_ = '\0'; if ( id != nullptr ) std::strcpy(id_, id); }
-    inline char const* id() const { return id_; }
+    inline void id(char const* id) { if ( id != nullptr ) id_.assign(id); else id_.clear(); }
+    inline char const* id() const { return id_.c_str(); }
 
     // Operators
     Bed4& operator=(const Bed4& c) {
       BaseClass::operator=(c);
-      std::strcpy(id_, c.id_);
+      id_ = c.id_;
       return *this;
     }
 
@@ -410,7 +474,18 @@ namespace Bed {
     using BaseClass::start_;
     using BaseClass::end_;
 
-    char id_[MAXIDSIZE+1];
+    Ext::ArenaString id_;
+
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr) {
+      int numScanned = BaseClass::scan(p, coords);
+      char const* tok;
+      std::size_t n;
+      if ( numScanned == 3 && Tokenize::token(p, tok, n) ) {
+        id_.assign(tok, std::min<std::size_t>(n, MAXIDSIZE));
+        ++numScanned;
+      }
+      return numScanned;
+    }
 
     static std::string outFormatter() {
       return(BaseClass::outFormatter() + "\t%s");
@@ -426,78 +501,62 @@ namespace Bed {
   struct Bed4 
     : public Bed4<BedType, false> {
 
-    Bed4() : BaseClass() { *fullrest_ = '\0'; }
+    Bed4() : BaseClass() { }
     Bed4(const Bed4& c)
-      : BaseClass(c)
-       {
-         *fullrest_ = '\0';
-         std::strcpy(fullrest_, c.fullrest_);
-       }
+      : BaseClass(c), fullrest_(c.fullrest_) { }
     explicit Bed4(FILE* inF) : BaseClass()
       { this->readline(inF); }
     explicit Bed4(const std::string& inS) : BaseClass()
       { this->readline(inS); }
+    explicit Bed4(char const* inS) : BaseClass()
+      { this->readline(inS); }
+    Bed4(char const* inS, char const* end) : BaseClass()
+      { this->readline(inS, nullptr, end); }
+    Bed4(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+      { this->readline(rest, &coords, end); }
 
     // Properties
-    inline char const* full_rest() const { return fullrest_; }
+    inline char const* full_rest() const { return fullrest_.c_str(); }
 
     // IO
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(fullrest_.c_str());
     }
-    inline void println() const {
-      static const std::string heapFormat = (outFormatter() + "\n");
-      static char const* format = heapFormat.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_)
-               + std::string(fullrest_); // fullrest_ has whitespace out front if needed
+               + std::string(fullrest_.c_str()); // fullrest_ has whitespace out front if needed
     }
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      static char other[MAXRESTSIZE+1];
-      other[0] = '\0';
-      chrom_[0] = '\0';
-      id_[0] = '\0';
-      fullrest_[0] = '\0';
-      int numScanned = std::sscanf(inputLine.c_str(),
-                                   format, chrom_,
-                                   &start_, &end_, id_,
-                                   other);
-      const int numWritten = std::snprintf(fullrest_, MAXRESTSIZE+1, "\t%s", id_);
-      if ( other[0] != '\0' && static_cast<CoordType>(numWritten) < MAXRESTSIZE )
-        std::snprintf(fullrest_ + numWritten, MAXRESTSIZE+1-numWritten, "%s", other);
-      return numScanned;
+      return readline(inputLine.c_str(), nullptr, inputLine.c_str() + inputLine.size());
+    }
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      id_.clear();
+      fullrest_.clear();
+      char const* p = inputLine;
+      return scan(p, coords, end);
     }
     inline int readline(FILE* inputFile) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      static char other[MAXRESTSIZE+1];
-      other[0] = '\0';
-      chrom_[0] = '\0';
-      id_[0] = '\0';
-      fullrest_[0] = '\0';
-      int numScanned = std::fscanf(inputFile,
-                                   format, chrom_,
-                                   &start_, &end_, id_,
-                                   other);
-
-      std::fgetc(inputFile); // Read and discard trailing newline
-      const int numWritten = std::snprintf(fullrest_, MAXRESTSIZE+1, "\t%s", id_);
-      if ( other[0] != '\0' && static_cast<CoordType>(numWritten) < MAXRESTSIZE )
-        std::snprintf(fullrest_ + numWritten, MAXRESTSIZE+1-numWritten, "%s", other);
-      return numScanned;
+      this->clear_chrom();
+      id_.clear();
+      fullrest_.clear();
+      char const* end;
+      char const* p = Tokenize::line(inputFile, end);
+      return p ? scan(p, nullptr, end) : EOF;
     }
 
     // Operators
     Bed4& operator=(const Bed4& c) {
       BaseClass::operator=(c);
-      std::strcpy(fullrest_, c.fullrest_);
+      fullrest_ = c.fullrest_;
       return *this;
     }
 
@@ -510,7 +569,28 @@ namespace Bed {
     using BaseClass::end_;
     using BaseClass::id_;
 
-    char fullrest_[MAXRESTSIZE + 1];
+    Ext::ArenaString fullrest_;
+
+    // fullrest_ is a tab, id_, then whatever followed id_ on the line, to MAXRESTSIZE
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      int numScanned = BaseClass::scan(p, coords);
+      char const* id = id_.c_str();
+      const std::size_t idsz = std::strlen(id);
+      const std::size_t numWritten = 1 + idsz;
+      std::size_t restsz = 0;
+      if ( numScanned == 4 && *p != '\0' && *p != '\n' ) {
+        ++numScanned;
+        if ( numWritten < MAXRESTSIZE )
+          restsz = std::min<std::size_t>(Tokenize::rest(p, end), MAXRESTSIZE - numWritten);
+      }
+      const std::size_t headsz = std::min<std::size_t>(numWritten, MAXRESTSIZE);
+      char* d = fullrest_.reset(headsz + restsz);
+      std::size_t len = 0;
+      Tokenize::cut(d, len, headsz, "\t", 1);
+      Tokenize::cut(d, len, headsz, id, idsz);
+      std::memcpy(d + headsz, p, restsz);
+      return numScanned;
+    }
 
     static std::string outFormatter() { /* BC::BC --> output 3 columns and fullrest_ */
       return(BaseClass::BaseClass::outFormatter() + "%s");
@@ -535,12 +615,18 @@ namespace Bed {
   struct Bed5<Bed4<U, Bed4HasRest>, MeasureType, false>
     : public Bed4<U, false> {
 
-    Bed5() : BaseClass() {}
+    Bed5() : BaseClass(), measurement_(0) {}
     Bed5(const Bed5& c) : BaseClass(c), measurement_(0) {}
     Bed5(char const* chrom, CoordType start, CoordType end, char const* id, MeasureType measurement)
         : BaseClass(chrom, start, end, id), measurement_(measurement) {}
     explicit Bed5(const std::string& inS) : BaseClass(), measurement_(0)
       { this->readline(inS); }
+    explicit Bed5(char const* inS) : BaseClass(), measurement_(0)
+      { this->readline(inS); }
+    Bed5(char const* inS, char const* end) : BaseClass(), measurement_(0)
+      { this->readline(inS, nullptr, end); }
+    Bed5(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass(), measurement_(0)
+      { this->readline(rest, &coords, end); }
     explicit Bed5(FILE* inF) : BaseClass(), measurement_(0)
       { this->readline(inF); }
 
@@ -554,41 +640,35 @@ namespace Bed {
 
     // IO
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      *chrom_ = '\0';
-      *id_ = '\0';
-      return std::sscanf(inputLine.c_str(),
-                         format, chrom_,
-                         &start_, &end_, id_,
-                         &measurement_);
-    }
-    inline int readline(FILE* inputFile) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      *chrom_ = '\0';
-      *id_ = '\0';
-      int numScanned = std::fscanf(inputFile,
-                                   format, chrom_,
-                                   &start_, &end_, id_,
-                                   &measurement_);
-      std::fgetc(inputFile); // Read and discard trailing newline
-      return numScanned;
+      return readline(inputLine.c_str());
     }
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_, id_, measurement_);
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      id_.clear();
+      char const* p = inputLine;
+      return scan(p, coords);
     }
-    inline void println() const {
-      static const std::string heapFormat = outFormatter() + "\n";
-      static char const* format = heapFormat.c_str();
-      std::printf(format, chrom_, start_, end_, id_, measurement_);
+    inline int readline(FILE* inputFile) {
+      this->clear_chrom();
+      id_.clear();
+      char const* p = Tokenize::line(inputFile);
+      return p ? scan(p) : EOF;
+    }
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_.c_str());
+      w.put('\t'); w.put(static_cast<MType>(measurement_));
+    }
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_) + tab
-               + std::string(id_) + tab + std::to_string(measurement_);
+               + std::string(id_.c_str()) + tab + std::to_string(measurement_);
     }
 
     // Operators
@@ -610,6 +690,13 @@ namespace Bed {
     typedef typename std::remove_cv<MeasureType>::type MType;
     static constexpr char const* MFormat = Formats::Format(MType());
 
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr) {
+      int numScanned = BaseClass::scan(p, coords);
+      if ( numScanned == 4 && Tokenize::measure(p, measurement_) )
+        ++numScanned;
+      return numScanned;
+    }
+
     static std::string outFormatter() {
       return(BaseClass::outFormatter() + "\t" + std::string(MFormat));
     }
@@ -625,89 +712,64 @@ namespace Bed {
   struct Bed5
     : public Bed5<Bed4Type, MeasureType, false> { /* Bed4Type is forced to be Bed4<> specialization above */
 
-    Bed5() : BaseClass() { *chrom_ = '\0'; *id_ = '\0'; *fullrest_ = '\0'; restOffset_ = -1; }
-    Bed5(const Bed5& c) : BaseClass(c), restOffset_(c.restOffset_)
-      {
-        *fullrest_ = '\0'; std::strcpy(fullrest_, c.fullrest_);
-      }
+    Bed5() : BaseClass(), restOffset_(-1) { }
+    Bed5(const Bed5& c) : BaseClass(c), restOffset_(c.restOffset_), fullrest_(c.fullrest_) { }
     explicit Bed5(FILE* inF) : BaseClass()
-      { *fullrest_ = '\0'; this->readline(inF); }
+      { this->readline(inF); }
     explicit Bed5(const std::string& inS) : BaseClass()
-      { *fullrest_ = '\0'; this->readline(inS); }
+      { this->readline(inS); }
+    explicit Bed5(char const* inS) : BaseClass()
+      { this->readline(inS); }
+    Bed5(char const* inS, char const* end) : BaseClass()
+      { this->readline(inS, nullptr, end); }
+    Bed5(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+      { this->readline(rest, &coords, end); }
 
     // Properties
-    inline char const* full_rest() const { return fullrest_; }
+    inline char const* full_rest() const { return fullrest_.c_str(); }
     inline int rest_offset() const { return restOffset_; }
 
     // IO
-    inline void print() const {
-      static const std::string lclStatic = outFormatter();
-      static char const* format = lclStatic.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    inline void print() const { print(Ext::StdOut()); }
+    inline void println() const { println(Ext::StdOut()); }
+    template <typename Writer>
+    inline void print(Writer& w) const {
+      w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(fullrest_.c_str());
     }
-    inline void println() const {
-      static const std::string heapFormat = outFormatter() + "\n";
-      static char const* format = heapFormat.c_str();
-      std::printf(format, chrom_, start_, end_, fullrest_);
+    template <typename Writer>
+    inline void println(Writer& w) const {
+      print(w); w.put('\n');
     }
     inline std::string printstr() const {
       static const std::string tab = "\t";
       return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_)
-               + std::string(fullrest_); // fullrest_ has whitespace out front if needed
+               + std::string(fullrest_.c_str()); // fullrest_ has whitespace out front if needed
     }
     inline int readline(const std::string& inputLine) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      static char other[MAXRESTSIZE+1];
-      other[0] = '\0';
-      *chrom_ = '\0';
-      *id_ = '\0';
-      *fullrest_ = '\0';
+      return readline(inputLine.c_str(), nullptr, inputLine.c_str() + inputLine.size());
+    }
+    inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      this->clear_chrom();
+      id_.clear();
+      fullrest_.clear();
       restOffset_ = -1;
-      const int numScanned = std::sscanf(inputLine.c_str(),
-                                         format, chrom_,
-                                         &start_, &end_, id_,
-                                         &measurement_, other);
-
-      static const std::string fstr = std::string("\t%s\t") + BaseClass::MFormat;
-      static const char* f = fstr.c_str();
-      const int numWritten = std::snprintf(fullrest_, MAXRESTSIZE+1, f, id_, measurement_);
-      if ( other[0] != '\0' && static_cast<CoordType>(numWritten) < MAXRESTSIZE ) {
-        restOffset_ = numWritten;
-        std::snprintf(fullrest_ + numWritten, MAXRESTSIZE+1-numWritten, "%s", other);
-      }
-      return numScanned;
+      char const* p = inputLine;
+      return scan(p, coords, end);
     }
     inline int readline(FILE* inputFile) {
-      static const std::string lclStatic = inFormatter();
-      static char const* format = lclStatic.c_str();
-      static char other[MAXRESTSIZE+1];
-      other[0] = '\0';
-      *chrom_ = '\0';
-      *id_ = '\0';
-      *fullrest_ = '\0';
+      this->clear_chrom();
+      id_.clear();
+      fullrest_.clear();
       restOffset_ = -1;
-      const int numScanned = std::fscanf(inputFile,
-                                         format, chrom_,
-                                         &start_, &end_, id_,
-                                         &measurement_, other);
-
-      std::fgetc(inputFile); // Read and discard trailing newline
-
-      static const std::string fstr = std::string("\t%s\t") + BaseClass::MFormat;
-      static const char* f = fstr.c_str();
-      const int numWritten = std::snprintf(fullrest_, MAXRESTSIZE+1, f, id_, measurement_);
-      if ( other[0] != '\0' && static_cast<CoordType>(numWritten) < MAXRESTSIZE ) {
-        restOffset_ = numWritten;
-        std::snprintf(fullrest_ + numWritten, MAXRESTSIZE+1-numWritten, "%s", other);
-      }
-      return numScanned;
+      char const* end;
+      char const* p = Tokenize::line(inputFile, end);
+      return p ? scan(p, nullptr, end) : EOF;
     }
 
     // Operators
     Bed5& operator=(const Bed5& c) {
       BaseClass::operator=(c);
-      std::strcpy(fullrest_, c.fullrest_);
+      fullrest_ = c.fullrest_;
       return *this;
     }
 
@@ -722,8 +784,42 @@ namespace Bed {
     using BaseClass::id_;
     using BaseClass::measurement_;
 
-    int  restOffset_; // marks spot after id_/measurement_ in fullrest_
-    char fullrest_[MAXRESTSIZE+1];
+    int restOffset_; // marks spot after id_/measurement_ in fullrest_
+    Ext::ArenaString fullrest_;
+
+    // fullrest_ is "\t%s\t" id_ and measurement_, then whatever followed them on the line, to MAXRESTSIZE
+    inline int scan(char const*& p, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+      int numScanned = BaseClass::scan(p, coords);
+      char mbuf[64];
+      std::string mbig;
+      char const* m = mbuf;
+      const int msz = Formats::PrintNumber(mbuf, sizeof(mbuf), static_cast<typename BaseClass::MType>(measurement_));
+      if ( msz >= static_cast<int>(sizeof(mbuf)) ) {
+        mbig.resize(msz + 1);
+        std::snprintf(&mbig[0], mbig.size(), BaseClass::MFormat, measurement_);
+        m = mbig.c_str();
+      }
+      char const* id = id_.c_str();
+      const std::size_t idsz = std::strlen(id);
+      const std::size_t numWritten = 2 + idsz + static_cast<std::size_t>(msz);
+      std::size_t restsz = 0;
+      if ( numScanned == 5 && *p != '\0' && *p != '\n' ) {
+        ++numScanned;
+        if ( numWritten < MAXRESTSIZE ) {
+          restOffset_ = static_cast<int>(numWritten);
+          restsz = std::min<std::size_t>(Tokenize::rest(p, end), MAXRESTSIZE - numWritten);
+        }
+      }
+      const std::size_t headsz = std::min<std::size_t>(numWritten, MAXRESTSIZE);
+      char* d = fullrest_.reset(headsz + restsz);
+      std::size_t len = 0;
+      Tokenize::cut(d, len, headsz, "\t", 1);
+      Tokenize::cut(d, len, headsz, id, idsz);
+      Tokenize::cut(d, len, headsz, "\t", 1);
+      Tokenize::cut(d, len, headsz, m, static_cast<std::size_t>(msz));
+      std::memcpy(d + headsz, p, restsz);
+      return numScanned;
+    }
 
     static std::string outFormatter() { /* BC::BC::BC --> output 3 columns and fullrest_ */
       return BaseClass::BaseClass::BaseClass::outFormatter() + "%s";
@@ -26,11 +26,14 @@
 
 #include <cctype>
 #include <cstddef>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <istream>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -45,15 +48,20 @@
 #include "suite/BEDOPS.Constants.hpp"
 #include "utility/ByLine.hpp"
 #include "utility/Exception.hpp"
+#include "utility/FastFormats.hpp"
+#include "utility/MappedFile.hpp"
 #include "utility/PooledMemory.hpp"
 
 namespace Bed {
 
-  template <class BedType, std::size_t SZ=Bed::CHUNKSZ>
+  // records come from, and go back to, a PoolType: PooledMemory by default;
+  //  Ext::ConcurrentPooledMemory if another thread releases them
+  template <class BedType, std::size_t SZ=Bed::CHUNKSZ,
+            class PoolType=Ext::PooledMemory<typename std::remove_pointer<BedType>::type, SZ>>
   class bed_check_iterator;
 
-  template <class BedType, std::size_t SZ>
-  class bed_check_iterator<BedType*, SZ> {
+  template <class BedType, std::size_t SZ, class PoolType>
+  class bed_check_iterator<BedType*, SZ, PoolType> {
 
   public:
     typedef Ext::UserError            Exception;
@@ -62,6 +70,7 @@ namespace Bed {
     typedef std::ptrdiff_t            difference_type;
     typedef BedType**                 pointer;
     typedef BedType*&                 reference;
+    typedef PoolType                  pool_type;
 
     static constexpr int nFields_  = BedType::NumFields;
     static constexpr bool hasRest_ = BedType::UseRest;
@@ -71,7 +80,7 @@ namespace Bed {
                            maxEnd_(0), chr_(""), isStarch_(false), all_(true), archive_(0), pool_(0)
       { /* */ }
 
-    bed_check_iterator(std::istream& is, const std::string& filename, Ext::PooledMemory<BedType, SZ>& p,
+    bed_check_iterator(std::istream& is, const std::string& filename, PoolType& p,
                        const std::string& chr = "all", bool nestCheck = false)
       : fp_(is), _M_ok(fp_), _M_value(0), fn_(filename), cnt_(0), lastChr_(""), lastRest_(""), lastStart_(1),
         lastEnd_(0), nestCheck_(nestCheck), maxEnd_(0), chr_(chr),
@@ -229,103 +238,146 @@ namespace Bed {
           } // while
         }
       }
+
+      if ( _M_ok && !isStarch_ && &fp_ != &std::cin && !is_namedpipe )
+        map_rest();
     }
 
     reference operator*() { return _M_value; }
     pointer operator->() { return &(operator*()); }
 
     bed_check_iterator& operator++() {
-      static Ext::ByLine bl;
-      if ( _M_ok ) {
-        if ( !isStarch_ ) { // bed
-          if ( (_M_ok = (fp_ && fp_ >> bl)) ) {
-            ++cnt_;
-            if ( !check(bl) ) {
-              std::stringstream s;
-              s << cnt_;
-              throw(Exception("in " + fn_ + "\nHeader found but should be at top of file.\nSee row: " + s.str()));
-            } else if ( !all_ && (_M_value->chrom() != chr_) ) {
-              pool_->release(_M_value);
-              _M_value = static_cast<BedType*>(0);
-              _M_ok = false;
-            }
-          }
-        } else { // starch
-          _M_ok = get_starch(bl);
-          if ( _M_ok ) {
-            ++cnt_;
-            check(bl);
-          }
-          _M_ok = (_M_ok && static_cast<bool>(_M_value) && 
-                   static_cast<bool>(archive_->getArchiveRecordIter()) &&
-                   !archive_->isEOF());
-        }
-      }
+      advance();
       return *this;
     }
 
     bed_check_iterator operator++(int)  {
       auto __tmp = *this;
-      static Ext::ByLine bl;
+      advance();
+      return __tmp;
+    }
+
+    PoolType& get_pool() { return *pool_; }
+
+    void clean() {
+      if ( archive_ )
+        delete archive_;
+    }
+
+    bool _M_equal(const bed_check_iterator& __x) const
+      { return ( (_M_ok == __x._M_ok) && (!_M_ok || &fp_ == &__x.fp_) ); }
+
+    bool operator=(const bed_check_iterator& b);
+
+    bool has_nested() const { /* only known for Starch archives */
+      if ( isStarch_ )
+        return archive_->getAllChromosomesHaveNestedElement();
+      return true; // assumption for BED
+    }
+
+  protected:
+    void advance() {
       if ( _M_ok ) {
         if ( !isStarch_ ) { // bed
-          if ( (_M_ok = (fp_ && fp_ >> bl)) ) {
+          char const* row = nullptr;
+          std::size_t sz = 0;
+          if ( (_M_ok = next_line(row, sz)) ) {
             ++cnt_;
-            if ( !check(bl) ) {
+            if ( !check(row, sz) ) {
               std::stringstream s;
               s << cnt_;
               throw(Exception("in " + fn_ + "\nHeader found but should be at top of file.\nSee row: " + s.str()));
-            } else if ( !all_ && (_M_value->chrom() != chr_ ) ) {
+            } else if ( !all_ && (_M_value->chrom() != chr_) ) {
               pool_->release(_M_value);
               _M_value = static_cast<BedType*>(0);
               _M_ok = false;
             }
           }
         } else { // starch
-          _M_ok = get_starch(bl);
+          _M_ok = get_starch(line_);
           if ( _M_ok ) {
             ++cnt_;
-            check(bl);
+            check(line_);
           }
           _M_ok = (_M_ok && static_cast<bool>(_M_value) && 
                    static_cast<bool>(archive_->getArchiveRecordIter()) &&
                    !archive_->isEOF());
         }
       }
-      return __tmp;
     }
 
-    Ext::PooledMemory<BedType, SZ>& get_pool() { return *pool_; }
-
-    void clean() {
-      if ( archive_ )
-        delete archive_;
+    // a regular BED file: rows past those already read through fp_ come
+    //  straight from an mmap() of the file.  Copies share map_, and with it
+    //  the read position, as they share fp_.
+    void map_rest() {
+      const std::istream::pos_type at = fp_.tellg();
+      if ( at == std::istream::pos_type(-1) )
+        return;
+      FILE* f = std::fopen(fn_.c_str(), "r");
+      if ( f == NULL )
+        return;
+      if ( std::fseek(f, static_cast<long>(at), SEEK_SET) == 0 ) {
+        std::shared_ptr<Ext::MappedFile> m = std::make_shared<Ext::MappedFile>(f);
+        if ( m->valid() )
+          map_ = m;
+      }
+      std::fclose(f); // the mapping outlives the descriptor
     }
 
-    bool _M_equal(const bed_check_iterator& __x) const
-      { return ( (_M_ok == __x._M_ok) && (!_M_ok || &fp_ == &__x.fp_) ); }
-
-    bool operator=(const bed_check_iterator& b);
-
-    bool has_nested() const { /* only known for Starch archives */
-      if ( isStarch_ )
-        return archive_->getAllChromosomesHaveNestedElement();
-      return true; // assumption for BED
+    // the next row without its '\n', as std::getline() gives it; false at the end
+    bool next_line(char const*& row, std::size_t& sz) {
+      if ( !map_ ) {
+        if ( !(fp_ && std::getline(fp_, line_)) )
+          return false;
+        row = line_.c_str();
+        sz = line_.size();
+        return true;
+      }
+      char const* b = map_->pos();
+      char const* e = map_->end();
+      if ( b == e )
+        return false;
+      char const* nl = static_cast<char const*>(std::memchr(b, '\n', static_cast<std::size_t>(e - b)));
+      if ( nl ) {
+        map_->pos(nl + 1);
+        row = b;
+        sz = static_cast<std::size_t>(nl - b);
+      } else { // no newline at the end of the file; copy so the row is terminated
+        tail_.assign(b, e);
+        map_->pos(e);
+        row = tail_.c_str();
+        sz = tail_.size();
+      }
+      return true;
     }
 
-  protected:
-    std::string lowerstr(const std::string& s) {
-      std::string t(s);
-      for ( std::size_t i = 0; i < t.size(); ++i )
-        t[i] = static_cast<char>(std::tolower(t[i]));
-      return t;
+    static bool isUCSCheader(char const* s, std::size_t sz) {
+      static char const* browser = "browser";
+      static char const* track = "track";
+      char const* h = (sz == 7) ? browser : ((sz == 5) ? track : nullptr);
+      if ( !h )
+        return false;
+      for ( std::size_t i = 0; i < sz; ++i ) {
+        if ( std::tolower(static_cast<unsigned char>(s[i])) != h[i] )
+          return false;
+      } // for
+      return true;
     }
 
-    bool isUCSCheader(const std::string& bl) {
-      std::string tmp = lowerstr(bl);
-      return (tmp == "browser" || tmp == "track");
+    // strcmp() of [a, a+sz) against b
+    static int compare(char const* a, std::size_t sz, char const* b) {
+      for ( std::size_t i = 0; ; ++i ) {
+        const unsigned char x = (i < sz) ? static_cast<unsigned char>(a[i]) : 0;
+        const unsigned char y = static_cast<unsigned char>(b[i]);
+        if ( x != y )
+          return (x < y) ? -1 : 1;
+        if ( x == 0 )
+          return 0;
+      } // for
     }
 
+    static bool isdigit(char c) { return static_cast<unsigned char>(c - '0') <= 9; }
+
     bool get_starch(std::string& line) {
       if ( archive_ == NULL || !archive_->extractBEDLine(line) )
         return false;
@@ -333,20 +385,43 @@ namespace Bed {
     }
 
     bool check(const std::string& bl) {
-      static std::string msg = "";
-      static int cmp = 0;
+      return check(bl.c_str(), bl.size());
+    }
+
+    // check() has already found the first 3 columns; the record reads only from rest on.
+    //  Types that only read text (Bed_minmem.hpp) take the row as they always did.
+    inline BedType* construct(char const*, char const* rest, const Bed::DecodedCoords& coords,
+                              char const* end, std::true_type) {
+      return pool_->construct(rest, coords, end);
+    }
+
+    inline BedType* construct(char const* row, char const*, const Bed::DecodedCoords&,
+                              char const*, std::false_type) {
+      return pool_->construct(row);
+    }
 
-      msg.clear();
-      if ( bl.empty() )
+    /*
+      One pass over the row, left to right, for everything --ec asks: column layout and types,
+        sizes against the compile-time limits, and then sort order against the previous row.
+        The messages, and which one wins when a row has several problems, are as they always
+        were.  The row ends at bl[sz], which may be a '\n' rather than a '\0'.  The chromosome
+        and coordinates found here go to the record as they are; it reads only the columns
+        past the 3rd.
+      false for a header row.
+    */
+    bool check(char const* bl, std::size_t sz) {
+      std::string msg;
+
+      if ( sz == 0 )
         msg = "Empty line found.";
-      else if ( isUCSCheader(bl) )
+      else if ( isUCSCheader(bl, sz) )
         return false;
 
       // Check chromosome
-      std::string::size_type marker = 0, sz = bl.size();
+      std::size_t marker = 0;
       while ( msg.empty() && marker < sz ) {
         if ( bl[marker] == ' ' ) {
-          if ( isUCSCheader(bl.substr(0, marker)) )
+          if ( isUCSCheader(bl, marker) )
             return false;
           msg = "First column should not have spaces.  Consider 'chr1' vs. 'chr1 '.  These are different names.\nsort-bed can correct this for you.";
         }
@@ -360,7 +435,7 @@ namespace Bed {
           if ( 0 == marker )
             msg = "First column name should not start with a tab.";
           else {
-            if ( isUCSCheader(bl.substr(0, marker)) )
+            if ( isUCSCheader(bl, marker) )
               return false;
             break;
           }
@@ -368,6 +443,7 @@ namespace Bed {
         ++marker;
       } // while
 
+      const std::size_t chromsz = marker;
       if ( msg.empty() ) {
         if ( sz <= marker )
           msg = "No tabs found in BED row.";
@@ -375,7 +451,7 @@ namespace Bed {
           msg = "Chromosome name does not fit in MAXCHROMSIZE chars.\nIncrease TOKEN_CHR_MAX_LENGTH in BEDOPS.Constants.hpp and recompile BEDOPS.";
           std::stringstream a, b;
           a << Bed::MAXCHROMSIZE;
-          b << bl.substr(0, marker).size();
+          b << marker;
           msg += "\nMAXCHROMSIZE = " + a.str();
           msg += "; Size given = " + b.str();
         }
@@ -383,12 +459,13 @@ namespace Bed {
           ++marker; // increment passed tab
       }
 
-
       // Check start coordinate
-      static std::string::size_type pos = marker;
-      pos = marker;
+      std::size_t pos = marker;
+      Bed::CoordType start = 0, end = 0; // digits only; wraps only where a check below fails
       while ( msg.empty() && marker < sz ) {
-        if ( !std::isdigit(bl[marker]) ) {
+        if ( isdigit(bl[marker]) )
+          start = start * 10 + static_cast<Bed::CoordType>(bl[marker] - '0');
+        else {
           if ( bl[marker] == '\t' && pos != marker )
             break;
           else if ( bl[marker] == '\t' )
@@ -411,9 +488,9 @@ namespace Bed {
         else {
           if ( marker-pos > MAX_DEC_INTEGERS )
             msg = "Sanity check failure - start coordinate has too many digits as defined by MAX_DEC_INTEGERS in BEDOPS.Constants.hpp";
-          else if ( std::atof(bl.substr(pos, marker-pos).c_str()) > double(MAX_COORD_VALUE) )
+          else if ( Formats::ParseDouble(bl + pos, nullptr) > double(MAX_COORD_VALUE) ) // digits only: atof()
             msg = "Sanity check failure - start coordinate is more than allowed by MAX_COORD_VALUE in BEDOPS.Constants.hpp";
-          else if ( std::atof(bl.substr(pos, marker-pos).c_str()) > std::numeric_limits<Bed::CoordType>::max() )
+          else if ( Formats::ParseDouble(bl + pos, nullptr) > std::numeric_limits<Bed::CoordType>::max() )
             msg = "Start coordinate exceeds limits of a Bed::CoordType on your system.";
           else
             ++marker; // increment passed tab
@@ -422,9 +499,11 @@ namespace Bed {
 
       // Check end coordinate
       pos = marker;
-      auto restMarker = marker;
+      const std::size_t restMarker = marker;
       while ( msg.empty() && marker < sz ) {
-        if ( !std::isdigit(bl[marker]) ) {
+        if ( isdigit(bl[marker]) )
+          end = end * 10 + static_cast<Bed::CoordType>(bl[marker] - '0');
+        else {
           if ( bl[marker] == '\t' && pos != marker )
             break;
           else if ( bl[marker] == '\t' )
@@ -440,6 +519,7 @@ namespace Bed {
         }
         ++marker;
       } // while
+      const std::size_t afterEnd = marker; // the tab ahead of the 4th column, or sz
 
       if ( msg.empty() ) {
         if ( sz <= marker && nFields_ > 3 ) {
@@ -449,9 +529,9 @@ namespace Bed {
         else {
           if ( marker-pos > MAX_DEC_INTEGERS )
             msg = "Sanity check failure - start coordinate has too many digits as defined by MAX_DEC_INTEGERS in BEDOPS.Constants.hpp";
-          else if ( std::atof(bl.substr(pos, marker-pos).c_str()) > double(MAX_COORD_VALUE) )
+          else if ( Formats::ParseDouble(bl + pos, nullptr) > double(MAX_COORD_VALUE) )
             msg = "Sanity check failure - start coordinate is more than allowed by MAX_COORD_VALUE in BEDOPS.Constants.hpp";
-          else if ( std::atof(bl.substr(pos, marker-pos).c_str()) > std::numeric_limits<Bed::CoordType>::max() )
+          else if ( Formats::ParseDouble(bl + pos, nullptr) > std::numeric_limits<Bed::CoordType>::max() )
             msg = "End coordinate exceeds limits of an Bed::CoordType on your system.";
           else
             ++marker; // increment passed tab
@@ -483,7 +563,7 @@ namespace Bed {
             msg = "ID field does not fit in MAXCHROMSIZE chars.\nIncrease TOKEN_ID_MAX_LENGTH in BEDOPS.Constants.hpp and recompile BEDOPS.";
             std::stringstream a, b;
             a << Bed::MAXIDSIZE;
-            b << bl.substr(pos, marker-pos).size();
+            b << (marker-pos);
             msg += "\nMAXIDSIZE = " + a.str();
             msg += "; Size given = " + b.str();
           }
@@ -495,18 +575,13 @@ namespace Bed {
 
         if ( nFields_ > 4 ) { // check measurement column
           pos = marker;
-          static int decimalCount = 0;
-          static int expCount = 0;
-          static std::size_t expPos = 0;
-          static int minusCount = 0;
-          static std::size_t minusPos = 0;
-          decimalCount = 0;
-          expCount = 0;
-          expPos = 0;
-          minusCount = 0;
-          minusPos = 0;
+          int decimalCount = 0;
+          int expCount = 0;
+          std::size_t expPos = 0;
+          int minusCount = 0;
+          std::size_t minusPos = 0;
           while ( msg.empty() && marker < sz ) {
-            if ( !std::isdigit(bl[marker]) ) {
+            if ( !isdigit(bl[marker]) ) {
               if ( bl[marker] == '\t' && pos != marker )
                 break;
               else if ( bl[marker] == '\t' )
@@ -591,7 +666,7 @@ namespace Bed {
         msg = "The 'rest' of the input row (everything beyond the first 3";
         std::stringstream a, b;
         a << Bed::MAXRESTSIZE;
-        b << bl.substr(marker).size();
+        b << (sz - marker);
         msg += " fields) cannot fit into MAXRESTSIZE chars.\nIncrease TOKEN_REST_MAX_LENGTH in BEDOPS.Constants.hpp and recompile BEDOPS.";
         msg += "\nMAXRESTSIZE = " + a.str();
         msg += "; Size given = " + b.str();
@@ -603,8 +678,11 @@ namespace Bed {
         throw(Exception("in " + fn_ + "\n" + msg + "\nSee row: " + s.str()));
       }
 
-      _M_value = pool_->construct(bl);
-      if ( msg.empty() && !lastChr_.empty() ) {
+      const Bed::DecodedCoords coords = { bl, chromsz, start, end };
+      _M_value = construct(bl, bl + afterEnd, coords, bl + sz,
+                           std::is_constructible<BedType, char const*, const Bed::DecodedCoords&, char const*>());
+      int cmp = 1;
+      if ( !lastChr_.empty() ) {
         cmp = std::strcmp(_M_value->chrom(), lastChr_.c_str());
         if ( cmp < 0 )
           msg = "Bed file not properly sorted by first column.";
@@ -615,7 +693,7 @@ namespace Bed {
             if ( _M_value->end() < lastEnd_ )
               msg = "Bed file not properly sorted by end coordinates when start coordinates are identical.";
             else if ( hasRest_ && _M_value->end() == lastEnd_ ) {
-              if ( std::strcmp(bl.substr(restMarker).c_str(), lastRest_.c_str()) < 0 )
+              if ( compare(bl + restMarker, sz - restMarker, lastRest_.c_str()) < 0 )
                 msg = "Bed file not sorted by information following the 3rd column (columns 1-3 equal to previous row).";
             }
           }
@@ -636,10 +714,12 @@ namespace Bed {
         throw(Exception("in " + fn_ + "\n" + msg + "\nSee row: " + s.str()));
       }
 
-      lastChr_ = _M_value->chrom();
+      if ( cmp != 0 ) // same chromosome: lastChr_ already holds it
+        lastChr_ = _M_value->chrom();
       lastStart_ = _M_value->start();
       lastEnd_ = _M_value->end();
-      lastRest_ = bl.substr(restMarker);
+      if ( hasRest_ )
+        lastRest_.assign(bl + restMarker, sz - restMarker);
       maxEnd_ = lastEnd_;
       return true;
     }
@@ -659,20 +739,22 @@ namespace Bed {
     bool isStarch_;
     const bool all_;
     starch::Starch* archive_;
-    Ext::PooledMemory<BedType, SZ>* pool_;
+    PoolType* pool_;
+    std::shared_ptr<Ext::MappedFile> map_;
+    std::string line_, tail_;
   };
 
-  template <class BedType, std::size_t Sz>
+  template <class BedType, std::size_t Sz, class PoolType>
   inline bool 
-  operator==(const bed_check_iterator<BedType, Sz>& __x,
-             const bed_check_iterator<BedType, Sz>& __y) {
+  operator==(const bed_check_iterator<BedType, Sz, PoolType>& __x,
+             const bed_check_iterator<BedType, Sz, PoolType>& __y) {
     return __x._M_equal(__y);
   }
 
-  template <class BedType, std::size_t Sz>
+  template <class BedType, std::size_t Sz, class PoolType>
   inline bool 
-  operator!=(const bed_check_iterator<BedType, Sz>& __x,
-             const bed_check_iterator<BedType, Sz>& __y) {
+  operator!=(const bed_check_iterator<BedType, Sz, PoolType>& __x,
+             const bed_check_iterator<BedType, Sz, PoolType>& __y) {
     return !__x._M_equal(__y);
   }
 
@@ -29,6 +29,8 @@
 #include <limits>
 #include <type_traits>
 
+#include "data/bed/ChromTable.hpp"
+
 namespace Bed {
 
   // Expect predicate function objects to be defined here
@@ -38,8 +40,8 @@ namespace Bed {
      : public std::binary_function<BedType1 const*, BedType2 const*, bool> {
 
     inline bool operator()(BedType1 const* ptr1, BedType2 const* ptr2) const {
-      static int v = 0;
-      if ( (v = std::strcmp(ptr1->chrom(), ptr2->chrom())) != 0 )
+      int v = 0;
+      if ( (v = chromcmp(ptr1, ptr2)) != 0 )
         return v < 0;
       if ( ptr1->start() != ptr2->start() )
         return ptr1->start() < ptr2->start();
@@ -52,8 +54,8 @@ namespace Bed {
      : public std::binary_function<BedType1 const*, BedType2 const*, bool> {
 
     inline bool operator()(BedType1 const* ptr1, BedType2 const* ptr2) const {
-      static int v = 0;
-      if ( (v = std::strcmp(ptr1->chrom(), ptr2->chrom())) != 0 )
+      int v = 0;
+      if ( (v = chromcmp(ptr1, ptr2)) != 0 )
         return v < 0;
       if ( ptr1->start() != ptr2->start() )
         return ptr1->start() < ptr2->start();
@@ -153,8 +155,8 @@ namespace Bed {
   struct GenomicRestCompare : CoordRestCompare<BedType1, BedType2> {
     typedef CoordRestCompare<BedType1, BedType2> BaseT;
     inline bool operator()(BedType1 const* ptr1, BedType2 const* ptr2) const {
-      static int v = 0;
-      if ( (v = std::strcmp(ptr1->chrom(), ptr2->chrom())) != 0 )
+      int v = 0;
+      if ( (v = chromcmp(ptr1, ptr2)) != 0 )
         return v < 0;
       return BaseT::operator()(ptr1, ptr2);
     }
@@ -221,8 +223,8 @@ namespace Bed {
   struct GenomicRestAddressCompare : CoordRestAddressCompare<BedType1, BedType2> {
     typedef CoordRestAddressCompare<BedType1, BedType2> BaseT;
     inline bool operator()(BedType1 const* ptr1, BedType2 const* ptr2) const {
-      static int v = 0;
-      if ( (v = std::strcmp(ptr1->chrom(), ptr2->chrom())) != 0 )
+      int v = 0;
+      if ( (v = chromcmp(ptr1, ptr2)) != 0 )
         return v < 0;
       return BaseT::operator()(ptr1, ptr2);
     }
@@ -304,8 +306,8 @@ namespace Bed {
       if ( one->measurement() != two->measurement() )
         return one->measurement() < two->measurement();
 
-      static int v = 0;
-      if ( (v = std::strcmp(one->chrom(), two->chrom())) != 0 )
+      int v = 0;
+      if ( (v = chromcmp(one, two)) != 0 )
         return v < 0;
       if ( one->start() != two->start() )
         return one->start() < two->start();
@@ -31,6 +31,7 @@
 #include <cstring>
 #include <limits>
 
+#include "data/bed/ChromTable.hpp"
 #include "suite/BEDOPS.Constants.hpp"
 
 namespace Bed {
@@ -56,7 +57,7 @@ namespace Bed {
     template <typename BedType1, typename BedType2>
     inline int operator()(BedType1 const* a, BedType2 const* b) const {
       static int v = 0;
-      if ( (v = std::strcmp(a->chrom(), b->chrom())) != 0 )
+      if ( (v = chromcmp(a, b)) != 0 )
         return((v > 0) ? 1 : -1);
       else if ( a->start() < b->end() )
         return((a->end() + maxDist_ > b->start()) ? 0 : -1);
@@ -96,7 +97,7 @@ namespace Bed {
     template <typename BedType1, typename BedType2>
     inline int operator()(BedType1 const* a, BedType2 const* b) const {
       static int v = 0;
-      if ( (v = std::strcmp(a->chrom(), b->chrom())) != 0 )
+      if ( (v = chromcmp(a, b)) != 0 )
         return ((v > 0) ? 1 : -1);
       CoordType mn = std::max(a->start(), b->start());
       CoordType mx = std::min(a->end(), b->end());
@@ -146,7 +147,7 @@ namespace Bed {
       static int direction = 0;
 
       // check if no overlap first
-      if ( (v = std::strcmp(refType->chrom(), mapType->chrom())) != 0 )
+      if ( (v = chromcmp(refType, mapType)) != 0 )
         return((v > 0) ? 1 : -1);
       else if ( refType->end() < mapType->start() )
         return(-1);
@@ -300,7 +301,7 @@ namespace Bed {
     template <typename T1, typename T2>
     inline int Ref2Map(T1 const* refType, T2 const* mapType) const {
       int v = 0;
-      if ( (v = std::strcmp(refType->chrom(), mapType->chrom())) != 0 )
+      if ( (v = chromcmp(refType, mapType)) != 0 )
         return v < 0 ? -1 : 1;
       else if ( refType->start() != mapType->start() )
         return refType->start() < mapType->start() ? -1 : 1;
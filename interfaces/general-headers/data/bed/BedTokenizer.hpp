@@ -0,0 +1,312 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 05:55:47 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef BED_TOKENIZER_HPP
+#define BED_TOKENIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <stdio.h> // ::getline()
+
+#include "utility/FastFormats.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BED_TOKENIZER_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define BED_TOKENIZER_AVX2 1 /* built per function, picked at run time */
+#endif
+#endif
+
+/*
+  Hand-rolled replacements for the fscanf()/sscanf() calls in the Bed classes.  Each
+    routine matches what its scanf() conversion did: "%s" skips leading whitespace
+    (including blank lines) and takes one non-whitespace token, "%SCNu64" skips
+    whitespace and takes an optionally-signed run of digits, "%[^\n]" takes
+    everything up to the newline and fails if that is nothing.  A '\t' in those
+    formats matched any run of whitespace, so every field here does too.
+  Nothing is copied here: text fields come back as spans of the line, which the Bed
+    classes cut at the MAX*SIZE limits their fixed buffers once had.  Unlike scanf(),
+    no field continues past a '\n', so a line can be parsed in place from a larger
+    buffer, such as a file mapping, which need not hold a '\0' anywhere.
+  The FILE* path reads exactly one line through stdio, so std::feof(), std::ftell()
+    and std::fseek() see the same stream positions the fscanf() + fgetc() pair left.
+  The rest of a row (everything past the columns a type parses) can run to kilobytes,
+    so eol() finds its end 64 bytes at a time with AVX2 or SSE2, whichever the CPU
+    has, or plain C++ elsewhere.  It is given the end of the row's buffer and loads
+    nothing outside [p, end): 64-byte blocks while they fit, then 16 or 8 bytes, the
+    last load of a size moved back to stop at end.  The getline() buffer, a
+    std::string, a file mapping and bed_check_iterator's rows all know where a row
+    stops; a bare char const* does not, and rest() leaves that one to std::strcspn(),
+    which the C library may speed up however it likes.  The leading columns are a
+    few bytes each and stay scalar; a vector block per field measured slower on
+    typical 3-6 column rows.
+*/
+
+namespace Bed {
+
+  namespace Tokenize {
+
+    inline bool isws(char c) {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // stops at the end of the line
+    inline char const* skipws(char const* p) {
+      while ( isws(*p) && *p != '\n' )
+        ++p;
+      return p;
+    }
+
+    // next line of inputFile, without its newline, or nullptr at EOF.  Lines that are
+    //  all whitespace are passed over, as "%s" would have.  The buffer is reused;
+    //  end is left at the line's terminating '\0'.
+    inline char const* line(FILE* inputFile, char const*& end) {
+      struct Buffer {
+        ~Buffer() { std::free(buf_); }
+        char* buf_ = nullptr;
+        std::size_t cap_ = 0;
+      };
+      static thread_local Buffer b;
+      ssize_t len;
+      while ( (len = ::getline(&b.buf_, &b.cap_, inputFile)) >= 0 ) {
+        if ( len > 0 && b.buf_[len-1] == '\n' )
+          b.buf_[--len] = '\0';
+        if ( *skipws(b.buf_) != '\0' ) {
+          end = b.buf_ + len;
+          return b.buf_;
+        }
+      } // while
+      return nullptr;
+    }
+
+    inline char const* line(FILE* inputFile) {
+      char const* end;
+      return line(inputFile, end);
+    }
+
+    // bit i set when block[i] is '\n' or '\0'; reads block[0] to block[63]
+    inline std::uint64_t eolmask_scalar(char const* block) {
+      std::uint64_t m = 0;
+      for ( int i = 0; i < 64; ++i )
+        m |= std::uint64_t(block[i] == '\n' || block[i] == '\0') << i;
+      return m;
+    }
+
+#if BED_TOKENIZER_SSE2
+    inline std::uint64_t eolmask_sse2(char const* block) {
+      const __m128i nul = _mm_setzero_si128();
+      const __m128i nl = _mm_set1_epi8('\n');
+      std::uint64_t m = 0;
+      for ( int i = 0; i < 4; ++i ) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block) + i);
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, nul), _mm_cmpeq_epi8(v, nl));
+        m |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(hit))) << (16 * i);
+      } // for
+      return m;
+    }
+#endif
+
+#if BED_TOKENIZER_AVX2
+    __attribute__((target("avx2")))
+    inline std::uint64_t eolmask_avx2(char const* block) {
+      const __m256i nul = _mm256_setzero_si256();
+      const __m256i nl = _mm256_set1_epi8('\n');
+      std::uint64_t m = 0;
+      for ( int i = 0; i < 2; ++i ) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block) + i);
+        const __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, nul), _mm256_cmpeq_epi8(v, nl));
+        m |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(hit))) << (32 * i);
+      } // for
+      return m;
+    }
+#endif
+
+    typedef std::uint64_t (*BlockMask)(char const*);
+
+    inline BlockMask pick_eolmask() {
+#if BED_TOKENIZER_AVX2
+      __builtin_cpu_init();
+      if ( __builtin_cpu_supports("avx2") )
+        return &eolmask_avx2;
+#endif
+#if BED_TOKENIZER_SSE2
+      return &eolmask_sse2;
+#else
+      return &eolmask_scalar;
+#endif
+    }
+
+    inline int lowbit(std::uint64_t v) { // v != 0
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(v);
+#else
+      int i = 0;
+      for ( ; !(v & 1); v >>= 1 )
+        ++i;
+      return i;
+#endif
+    }
+
+#if BED_TOKENIZER_SSE2
+    // eolmask_sse2() for 16 bytes, or for 8 from a 64-bit load
+    inline int eolmask16(__m128i v) {
+      return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_setzero_si128()), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+    }
+    inline int eolmask16(char const* p) { return eolmask16(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))); }
+    inline int eolmask8(char const* p) { return eolmask16(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(p))) & 0xff; }
+#endif
+
+    // first '\n' or '\0' in [p, end), or end if there is none.  The last load of each
+    //  size is moved back to finish exactly at end; whatever it reads twice was already
+    //  searched and found clean.
+    inline char const* eol(char const* p, char const* end) {
+      static const BlockMask mask = pick_eolmask();
+      std::uint64_t m;
+      if ( end - p >= 64 ) {
+        for ( ; end - p > 64; p += 64 ) {
+          if ( (m = mask(p)) )
+            return p + lowbit(m);
+        } // for
+        p = end - 64;
+        return (m = mask(p)) ? p + lowbit(m) : end;
+      }
+#if BED_TOKENIZER_SSE2
+      if ( end - p >= 16 ) {
+        for ( ; end - p > 16; p += 16 ) {
+          if ( (m = static_cast<std::uint64_t>(eolmask16(p))) )
+            return p + lowbit(m);
+        } // for
+        p = end - 16;
+        return (m = static_cast<std::uint64_t>(eolmask16(p))) ? p + lowbit(m) : end;
+      }
+      if ( end - p >= 8 ) {
+        if ( (m = static_cast<std::uint64_t>(eolmask8(p))) )
+          return p + lowbit(m);
+        p = end - 8;
+        return (m = static_cast<std::uint64_t>(eolmask8(p))) ? p + lowbit(m) : end;
+      }
+#endif
+      while ( p != end && *p != '\n' && *p != '\0' )
+        ++p;
+      return p;
+    }
+
+    // "%s" : [tok, tok+n) is the next token
+    inline bool token(char const*& p, char const*& tok, std::size_t& n) {
+      p = skipws(p);
+      char const* q = p;
+      while ( *q != '\0' && !isws(*q) )
+        ++q;
+      if ( q == p )
+        return false;
+      tok = p;
+      n = static_cast<std::size_t>(q - p);
+      p = q;
+      return true;
+    }
+
+    // "%" SCNu64 : a sign is accepted and applied in unsigned arithmetic, as strtoull() does;
+    //  a value too large for T saturates to its max, sign or not, as strtoull() does too
+    template <typename T>
+    inline bool coord(char const*& p, T& value) {
+      static constexpr T mx = std::numeric_limits<T>::max();
+      p = skipws(p);
+      char const* q = p;
+      const bool neg = (*q == '-');
+      if ( neg || *q == '+' )
+        ++q;
+      if ( static_cast<unsigned char>(*q - '0') > 9 )
+        return false;
+      T v = 0;
+      bool over = false;
+      do {
+        const T d = static_cast<T>(*q - '0');
+        if ( over || v > (mx - d) / 10 )
+          over = true;
+        else
+          v = v * 10 + d;
+      } while ( static_cast<unsigned char>(*++q - '0') <= 9 );
+      value = over ? mx : (neg ? static_cast<T>(0 - v) : v);
+      p = q;
+      return true;
+    }
+
+    // Formats::Format(T) : the measurement column
+    inline bool convert(char const* p, char** q, double& v) { v = Formats::ParseDouble(p, q); return true; }
+    inline bool convert(char const* p, char** q, float& v) { v = std::strtof(p, q); return true; }
+    inline bool convert(char const* p, char** q, long double& v) { v = std::strtold(p, q); return true; }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value, bool>::type
+    convert(char const* p, char** q, T& v) {
+      if ( std::is_signed<T>::value )
+        v = static_cast<T>(std::strtoll(p, q, 10));
+      else
+        v = static_cast<T>(std::strtoull(p, q, 10));
+      return true;
+    }
+
+    template <typename T>
+    inline bool measure(char const*& p, T& value) {
+      p = skipws(p);
+      if ( *p == '\n' ) // strtod() and friends would skip it
+        return false;
+      char* q = nullptr;
+      T v;
+      convert(p, &q, v);
+      if ( q == p )
+        return false;
+      value = v;
+      p = q;
+      return true;
+    }
+
+    // "%[^\n]" : the length of what remains of the line, 0 failing.  end is the end
+    //  of the row's buffer when the caller knows it, else nullptr.
+    inline std::size_t rest(char const* p, char const* end) {
+      if ( !end )
+        return std::strcspn(p, "\n");
+      return static_cast<std::size_t>(eol(p, end) - p);
+    }
+
+    // appends [s, s+n) at dest+len, never past dest+max : how snprintf() cut fullrest_
+    inline void cut(char* dest, std::size_t& len, std::size_t max, char const* s, std::size_t n) {
+      if ( n > max - len )
+        n = max - len;
+      std::memcpy(dest + len, s, n);
+      len += n;
+    }
+
+  } // namespace Tokenize
+
+} // namespace Bed
+
+#endif // BED_TOKENIZER_HPP
@@ -26,6 +26,7 @@
 #define BEDTYPES_HPP
 
 #include "data/bed/Bed.hpp"
+#include "data/bed/Bed_lazy.hpp"
 #include "data/bed/Bed_minmem.hpp"
 #include "suite/BEDOPS.Constants.hpp"
 
@@ -79,6 +80,11 @@ namespace Bed {
 
   typedef BTAllRestNoPool::Bed5Type   B5RestNoPool;
   typedef BTAllNoRestNoPool::Bed5Type B5NoRestNoPool;
+
+
+  // id, measurement and rest decoded on first use; see Bed_lazy.hpp
+  typedef Lazy::Bed4<AllChrom>                        B4RestLazy;
+  typedef Lazy::Bed5<AllChrom, Bed::MeasurementType>  B5RestLazy;
 } // namespace Bed
 
 #endif // BEDTYPES_HPP
@@ -0,0 +1,345 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 08:04:44 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef BED_LAZY_HPP
+#define BED_LAZY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "data/bed/Bed.hpp"
+#include "data/bed/BedTokenizer.hpp"
+#include "utility/ByteArena.hpp"
+#include "utility/FastFormats.hpp"
+#include "utility/Formats.hpp"
+#include "utility/OutputBuffer.hpp"
+
+/*
+  Stand-ins for Bed4<..., Rest> and Bed5<..., Rest> that parse only the 3 coordinate
+    columns up front.  The rest of the line is kept as read, with the id column cut
+    and terminated in place, and the measurement and full_rest() are worked out the
+    first time something asks for them.  A row that never lands in a window, or a
+    row whose score no visitor wants, never pays for strtod() or for formatting the
+    score back into full_rest().  What comes back is exactly what the eager types
+    give.
+  Decoding happens inside const accessors, so a record must not be read from two
+    threads at once.  readline() counts the columns present without converting them.
+*/
+
+namespace Bed {
+
+  namespace Lazy {
+
+    /*****************************************/
+    /* Bed4 Class                            */
+    /*****************************************/
+
+    template <bool IsNonStaticChrom = true>
+    struct Bed4 : public BasicCoords<IsNonStaticChrom, false> {
+
+      Bed4() : BaseClass(), tailOff_(0), built_(false) { }
+      /* Desire default-shallow copy-construction & copy-assignment */
+      explicit Bed4(FILE* inF) : BaseClass()
+        { this->readline(inF); }
+      explicit Bed4(const std::string& inS) : BaseClass()
+        { this->readline(inS); }
+      explicit Bed4(char const* inS) : BaseClass()
+        { this->readline(inS); }
+      Bed4(char const* inS, char const* end) : BaseClass()
+        { this->readline(inS, nullptr, end); }
+      Bed4(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+        { this->readline(rest, &coords, end); }
+
+      // Properties
+      inline char const* id() const { return raw_.c_str(); }
+      inline char const* full_rest() const {
+        if ( !built_ )
+          build();
+        return fullrest_.c_str();
+      }
+
+      // IO
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(full_rest());
+      }
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
+      }
+      inline std::string printstr() const {
+        static const std::string tab = "\t";
+        return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_)
+                 + std::string(full_rest());
+      }
+      inline int readline(const std::string& inputLine) {
+        return readline(inputLine.c_str(), nullptr, inputLine.c_str() + inputLine.size());
+      }
+      inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+        char const* p = inputLine;
+        return scan(p, 0, coords, end);
+      }
+      inline int readline(FILE* inputFile) {
+        char const* end;
+        char const* p = Tokenize::line(inputFile, end);
+        if ( !p ) {
+          reset();
+          return EOF;
+        }
+        return scan(p, 0, nullptr, end);
+      }
+
+      static const int NumFields = 4;
+      static const bool UseRest = true;
+
+    protected:
+      typedef BasicCoords<IsNonStaticChrom, false> BaseClass;
+      using BaseClass::chrom_;
+      using BaseClass::start_;
+      using BaseClass::end_;
+
+      // raw_ : the id (to MAXIDSIZE) and a '\0', then from tailOff_ whatever
+      //         followed the id on the line, to MAXRESTSIZE past the columns
+      //         scan() was asked to keep whole
+      Ext::ArenaString raw_;
+      std::uint32_t tailOff_;
+      mutable bool built_;
+      mutable Ext::ArenaString fullrest_;
+
+      inline void reset() {
+        this->clear_chrom();
+        raw_.clear();
+        tailOff_ = 0;
+        built_ = false;
+        fullrest_.clear();
+      }
+
+      inline char const* tail() const { return raw_.c_str() + tailOff_; }
+
+      // keeps the line past the id; lastTok more columns are kept whole ahead of
+      //  the MAXRESTSIZE cut, so a derived type can still cut exactly as before
+      inline int scan(char const*& p, int lastTok = 0, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+        reset();
+        int numScanned = BaseClass::scan(p, coords);
+        char const* tok;
+        std::size_t n;
+        if ( numScanned != 3 || !Tokenize::token(p, tok, n) )
+          return numScanned;
+        ++numScanned;
+        char const* q = p;
+        char const* last = p;
+        for ( int i = 0; i < lastTok && Tokenize::token(q, last, n); ++i ) {
+          last += n;
+          ++numScanned;
+        } // for
+        const std::size_t idsz = std::min<std::size_t>(static_cast<std::size_t>(p - tok), MAXIDSIZE);
+        const std::size_t tailsz = std::min<std::size_t>(Tokenize::rest(p, end), (last - p) + MAXRESTSIZE);
+        char* d = raw_.reset(idsz + 1 + tailsz);
+        std::memcpy(d, tok, idsz);
+        d[idsz] = '\0';
+        std::memcpy(d + idsz + 1, p, tailsz);
+        tailOff_ = static_cast<std::uint32_t>(idsz + 1);
+        return numScanned + (lastTok == 0 && tailsz != 0);
+      }
+
+      // fullrest_ is a tab, the id, then whatever followed it on the line, to MAXRESTSIZE
+      inline void build() const {
+        char const* id = this->id();
+        const std::size_t idsz = tailOff_ ? tailOff_ - 1 : 0;
+        const std::size_t numWritten = 1 + idsz;
+        std::size_t restsz = 0;
+        if ( numWritten < MAXRESTSIZE )
+          restsz = std::min<std::size_t>(std::strlen(tail()), MAXRESTSIZE - numWritten);
+        const std::size_t headsz = std::min<std::size_t>(numWritten, MAXRESTSIZE);
+        char* d = fullrest_.reset(headsz + restsz);
+        std::size_t len = 0;
+        Tokenize::cut(d, len, headsz, "\t", 1);
+        Tokenize::cut(d, len, headsz, id, idsz);
+        std::memcpy(d + headsz, tail(), restsz);
+        built_ = true;
+      }
+    };
+
+
+    /*****************************************/
+    /* Bed5 Class                            */
+    /*****************************************/
+
+    template <bool IsNonStaticChrom = true, typename MeasureType = Bed::MeasurementType>
+    struct Bed5 : public Bed4<IsNonStaticChrom> {
+
+      Bed5() : BaseClass(), measured_(false), measurement_(0), mEnd_(0), restOffset_(-1) { }
+      /* Desire default-shallow copy-construction & copy-assignment */
+      explicit Bed5(FILE* inF) : BaseClass()
+        { this->readline(inF); }
+      explicit Bed5(const std::string& inS) : BaseClass()
+        { this->readline(inS); }
+      explicit Bed5(char const* inS) : BaseClass()
+        { this->readline(inS); }
+      Bed5(char const* inS, char const* end) : BaseClass()
+        { this->readline(inS, nullptr, end); }
+      Bed5(char const* rest, const DecodedCoords& coords, char const* end = nullptr) : BaseClass()
+        { this->readline(rest, &coords, end); }
+
+      // Parameters
+      typedef MeasureType MeasurementType;
+      static const int NumFields = 5;
+      static const bool UseRest = true;
+
+      // Properties
+      inline MeasurementType measurement() const {
+        if ( !measured_ )
+          measure();
+        return measurement_;
+      }
+      inline char const* full_rest() const {
+        if ( !built_ )
+          build();
+        return fullrest_.c_str();
+      }
+      inline int rest_offset() const {
+        if ( !built_ )
+          build();
+        return restOffset_;
+      }
+
+      // IO
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(full_rest());
+      }
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
+      }
+      inline std::string printstr() const {
+        static const std::string tab = "\t";
+        return std::string(chrom_) + tab + std::to_string(start_) + tab + std::to_string(end_)
+                 + std::string(full_rest());
+      }
+      inline int readline(const std::string& inputLine) {
+        return readline(inputLine.c_str(), nullptr, inputLine.c_str() + inputLine.size());
+      }
+      inline int readline(char const* inputLine, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+        char const* p = inputLine;
+        return scan(p, coords, end);
+      }
+      inline int readline(FILE* inputFile) {
+        char const* end;
+        char const* p = Tokenize::line(inputFile, end);
+        if ( !p ) {
+          reset();
+          return EOF;
+        }
+        return scan(p, nullptr, end);
+      }
+
+      // Operators
+      inline operator MeasurementType() const { return measurement(); }
+
+    protected:
+      typedef Bed4<IsNonStaticChrom> BaseClass;
+      using BaseClass::chrom_;
+      using BaseClass::start_;
+      using BaseClass::end_;
+      using BaseClass::raw_;
+      using BaseClass::tailOff_;
+      using BaseClass::built_;
+      using BaseClass::fullrest_;
+
+      typedef typename std::remove_cv<MeasureType>::type MType;
+      static constexpr char const* MFormat = Formats::Format(MType());
+
+      mutable bool measured_;
+      mutable MeasureType measurement_;
+      mutable std::uint32_t mEnd_; // tail() offset past the measurement; 0 if it did not convert
+      mutable int restOffset_;
+
+      inline void reset() {
+        BaseClass::reset();
+        measured_ = false;
+        measurement_ = 0;
+        mEnd_ = 0;
+        restOffset_ = -1;
+      }
+
+      inline int scan(char const*& p, const DecodedCoords* coords = nullptr, char const* end = nullptr) {
+        reset();
+        return BaseClass::scan(p, 1, coords, end);
+      }
+
+      inline void measure() const {
+        char const* t = this->tail();
+        char const* p = t;
+        if ( tailOff_ && Tokenize::measure(p, measurement_) )
+          mEnd_ = static_cast<std::uint32_t>(p - t);
+        measured_ = true;
+      }
+
+      // fullrest_ is "\t%s\t" id and measurement, then whatever followed them on the line, to MAXRESTSIZE
+      inline void build() const {
+        const MeasureType m = measurement();
+        char mbuf[64];
+        std::string mbig;
+        char const* ms = mbuf;
+        const int msz = Formats::PrintNumber(mbuf, sizeof(mbuf), static_cast<MType>(m));
+        if ( msz >= static_cast<int>(sizeof(mbuf)) ) {
+          mbig.resize(msz + 1);
+          std::snprintf(&mbig[0], mbig.size(), MFormat, m);
+          ms = mbig.c_str();
+        }
+        char const* id = this->id();
+        const std::size_t idsz = tailOff_ ? tailOff_ - 1 : 0;
+        const std::size_t numWritten = 2 + idsz + static_cast<std::size_t>(msz);
+        char const* rest = this->tail() + mEnd_;
+        std::size_t restsz = 0;
+        if ( mEnd_ && *rest != '\0' && numWritten < MAXRESTSIZE ) {
+          restOffset_ = static_cast<int>(numWritten);
+          restsz = std::min<std::size_t>(std::strlen(rest), MAXRESTSIZE - numWritten);
+        }
+        const std::size_t headsz = std::min<std::size_t>(numWritten, MAXRESTSIZE);
+        char* d = fullrest_.reset(headsz + restsz);
+        std::size_t len = 0;
+        Tokenize::cut(d, len, headsz, "\t", 1);
+        Tokenize::cut(d, len, headsz, id, idsz);
+        Tokenize::cut(d, len, headsz, "\t", 1);
+        Tokenize::cut(d, len, headsz, ms, static_cast<std::size_t>(msz));
+        std::memcpy(d + headsz, rest, restsz);
+        built_ = true;
+      }
+    };
+
+  } // namespace Lazy
+
+} // namespace Bed
+
+#endif // BED_LAZY_HPP
@@ -34,6 +34,7 @@
 
 #include "suite/BEDOPS.Constants.hpp"
 #include "utility/Formats.hpp"
+#include "utility/OutputBuffer.hpp"
 
 /*
   sjn
@@ -219,15 +220,15 @@ namespace Bed {
       }
 
       // IO
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_);
       }
-      inline void println() const {
-        static const std::string heapFormat = (outFormatter() + "\n");
-        static char const* format = heapFormat.c_str();
-        std::printf(format, chrom_, start_, end_);
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
       inline int readline(const std::string& inputLine) {
         static char chrBuf[MAXCHROMSIZE + 1];
@@ -312,15 +313,15 @@ namespace Bed {
       }
 
       // IO
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_, rest_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put(rest_);
       }
-      inline void println() const {
-        static const std::string heapFormat = (outFormatter() + "\n");
-        static char const* format = heapFormat.c_str();
-        std::printf(format, chrom_, start_, end_, rest_);
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
       inline int readline(const std::string& inputLine) {
         static char chrBuf[MAXCHROMSIZE + 1];
@@ -443,15 +444,15 @@ namespace Bed {
         this->id(idBuf);
         return numScanned;
       }
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_, id_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_);
       }
-      inline void println() const {
-        static const std::string heapFormat = (outFormatter() + "\n");
-        static char const* format = heapFormat.c_str();
-        printf(format, chrom_, start_, end_, id_);
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
 
       // Properties
@@ -536,15 +537,15 @@ namespace Bed {
       char const* full_rest() const { return fullrest_; }
 
       // IO
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_, id_, rest_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_); w.put(rest_);
       }
-      inline void println() const {
-        static const std::string heapFormat = (outFormatter() + "\n");
-        static char const* format = heapFormat.c_str();
-        std::printf(format, chrom_, start_, end_, id_, rest_);
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
       inline int readline(const std::string& inputLine) {
         static char chrBuf[MAXCHROMSIZE + 1];
@@ -709,15 +710,16 @@ namespace Bed {
         this->id(idBuf);
         return numScanned;
       }
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_, id_, measurement_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_);
+        w.put('\t'); w.put(measurement_);
       }
-      inline void println() const {
-        static const std::string heapFormat = outFormatter() + "\n";
-        static char const* format = heapFormat.c_str();
-        std::printf(format, chrom_, start_, end_, id_, measurement_);
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
 
       // Operators
@@ -788,15 +790,16 @@ namespace Bed {
       int rest_offset() const { return restOffset_; }
 
       // IO
-      inline void print() const {
-        static const std::string lclStatic = outFormatter();
-        static char const* format = lclStatic.c_str();
-        std::printf(format, chrom_, start_, end_, id_, measurement_, rest_);
-      }
-      inline void println() const {
-        static const std::string heapFormat = outFormatter() + "\n";
-        static char const* format = heapFormat.c_str();
-        std::printf(format, chrom_, start_, end_, id_, measurement_, rest_);
+      inline void print() const { print(Ext::StdOut()); }
+      inline void println() const { println(Ext::StdOut()); }
+      template <typename Writer>
+      inline void print(Writer& w) const {
+        w.put(chrom_); w.put('\t'); w.put(start_); w.put('\t'); w.put(end_); w.put('\t'); w.put(id_);
+        w.put('\t'); w.put(measurement_); w.put(rest_);
+      }
+      template <typename Writer>
+      inline void println(Writer& w) const {
+        print(w); w.put('\n');
       }
       inline int readline(const std::string& inputLine) {
         static char chrBuf[MAXCHROMSIZE + 1];
@@ -0,0 +1,153 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 07:05:28 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef BED_CHROM_TABLE_HPP
+#define BED_CHROM_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+namespace Bed {
+
+  //===========
+  // ChromTable : process-wide interned chromosome names.  intern() returns the
+  //               same pointer for equal names, valid until the program exits,
+  //               so records hold a pointer in place of a copy of the name.
+  //              Each name also gets an ordinal that sorts the way std::strcmp()
+  //               (and so sort-bed) orders the names.  Ordinals never change:
+  //               a new name takes the midpoint of the gap between its
+  //               neighbors.  Should a gap run out, ordered() turns false for
+  //               good and compare() falls back to std::strcmp().
+  //              Sorted input repeats one name for many rows, so each thread
+  //               checks the name it saw last before taking the lock.
+  //===========
+  struct ChromTable {
+    typedef std::uint64_t Ordinal;
+
+    static char const* intern(char const* s, std::size_t n, Ordinal& ord) {
+      static thread_local Entry const* last = nullptr;
+      if ( !last || n != last->first.size() || std::memcmp(s, last->first.data(), n) != 0 )
+        last = insert(s, n);
+      ord = last->second;
+      return last->first.c_str();
+    }
+
+    static inline char const* intern(char const* s, std::size_t n) {
+      Ordinal ord;
+      return intern(s, n, ord);
+    }
+
+    static inline char const* intern(char const* s) { return intern(s, std::strlen(s)); }
+
+    static inline char const* empty(Ordinal& ord) {
+      static Ordinal eord = 0;
+      static char const* const e = intern("", 0, eord);
+      ord = eord;
+      return e;
+    }
+
+    static inline bool ordered() { return ordered_().load(std::memory_order_relaxed); }
+
+    // a and b came from intern(), along with aord and bord
+    static inline int compare(char const* a, Ordinal aord, char const* b, Ordinal bord) {
+      if ( a == b )
+        return 0;
+      if ( aord != bord && ordered() )
+        return (aord < bord) ? -1 : 1;
+      return std::strcmp(a, b);
+    }
+
+  private:
+    typedef std::map<std::string, Ordinal> Names;
+    typedef Names::value_type Entry;
+
+    static constexpr Ordinal Gap = Ordinal(1) << 32;
+
+    static std::atomic<bool>& ordered_() {
+      static std::atomic<bool> o(true);
+      return o;
+    }
+
+    static Entry const* insert(char const* s, std::size_t n) {
+      static std::mutex m;
+      static auto* names = new Names; // outlives every record; nodes never move
+      std::lock_guard<std::mutex> lock(m);
+      auto r = names->insert(Entry(std::string(s, n), 0));
+      if ( !r.second )
+        return &*r.first;
+
+      constexpr Ordinal top = std::numeric_limits<Ordinal>::max();
+      const bool hasPrev = (r.first != names->begin());
+      auto next = std::next(r.first);
+      const bool hasNext = (next != names->end());
+      Ordinal lo = hasPrev ? std::prev(r.first)->second : 0;
+      Ordinal hi = hasNext ? next->second : top;
+      Ordinal& ord = r.first->second;
+      if ( !hasPrev && !hasNext )
+        ord = Ordinal(1) << 63;
+      else if ( !hasNext && top - lo > Gap ) // names mostly arrive in sorted order
+        ord = lo + Gap;
+      else if ( !hasPrev && hi > Gap )
+        ord = hi - Gap;
+      else {
+        ord = lo + (hi - lo) / 2;
+        if ( ord == lo || ord == hi )
+          ordered_().store(false, std::memory_order_relaxed);
+      }
+      return &*r.first;
+    }
+  };
+
+  namespace ChromDetails {
+    template <typename T>
+    struct HasOrdinal {
+      template <typename U> static auto test(U const* u) -> decltype(u->chromOrdinal(), std::true_type());
+      template <typename U> static std::false_type test(...);
+      static constexpr bool value = decltype(test<T>(nullptr))::value;
+    };
+  } // namespace ChromDetails
+
+  // std::strcmp() of a's and b's chromosomes, through ChromTable when both are interned
+  template <typename T, typename U>
+  inline typename std::enable_if<ChromDetails::HasOrdinal<T>::value && ChromDetails::HasOrdinal<U>::value, int>::type
+  chromcmp(T const* a, U const* b) {
+    return ChromTable::compare(a->chrom(), a->chromOrdinal(), b->chrom(), b->chromOrdinal());
+  }
+
+  template <typename T, typename U>
+  inline typename std::enable_if<!ChromDetails::HasOrdinal<T>::value || !ChromDetails::HasOrdinal<U>::value, int>::type
+  chromcmp(T const* a, U const* b) {
+    return std::strcmp(a->chrom(), b->chrom());
+  }
+
+} // namespace Bed
+
+#endif // BED_CHROM_TABLE_HPP
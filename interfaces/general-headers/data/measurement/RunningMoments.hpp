@@ -0,0 +1,124 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 04:23:06 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef _RUNNING_MOMENTS_HPP
+#define _RUNNING_MOMENTS_HPP
+
+#include <cmath>
+#include <memory>
+
+namespace Signal {
+
+  //=============
+  // NeumaierSum : compensated running sum.  A sliding window adds and then
+  //                removes every value; the low-order bits lost on each of
+  //                those steps are kept in comp_ rather than left to drift.
+  //               Once the sum is inf or nan there are no low-order bits to
+  //                keep: (x - t) would be inf - inf.  comp_ is left alone and
+  //                value() is the plain sum, as an uncompensated sum gives.
+  //=============
+  template <typename T>
+  struct NeumaierSum {
+    NeumaierSum() : sum_(0), comp_(0) { /* */ }
+
+    inline void add(T x) {
+      const T t = sum_ + x;
+      if ( std::isfinite(t) ) {
+        if ( std::fabs(sum_) >= std::fabs(x) )
+          comp_ += (sum_ - t) + x;
+        else
+          comp_ += (x - t) + sum_;
+      }
+      sum_ = t;
+    }
+
+    inline T value() const { return std::isfinite(sum_) ? sum_ + comp_ : sum_; }
+    inline void reset() { sum_ = 0; comp_ = 0; }
+
+  private:
+    T sum_;
+    T comp_;
+  };
+
+  //================
+  // RunningMoments : count, sum and sum of squares of a sliding window, each
+  //                   O(1) per addition or removal.  The sums start over
+  //                   from exact zero whenever the window empties.
+  //                  One instance may be shared by several visitors (see
+  //                   Visitors::Average, Sum, Variance, StdDev, CoeffVariation):
+  //                   the first to claim() it keeps it up to date and the
+  //                   others only read from it.
+  //================
+  template <typename T>
+  struct RunningMoments {
+    typedef std::shared_ptr<RunningMoments> Shared;
+
+    RunningMoments() : n_(0), claimed_(false) { /* */ }
+
+    inline bool claim() {
+      const bool first = !claimed_;
+      claimed_ = true;
+      return first;
+    }
+
+    inline void add(T x) {
+      ++n_;
+      sum_.add(x);
+      sq_.add(x * x);
+    }
+
+    inline void remove(T x) {
+      if ( --n_ == 0 ) {
+        reset();
+      } else {
+        sum_.add(-x);
+        sq_.add(-(x * x));
+      }
+    }
+
+    inline void reset() {
+      n_ = 0;
+      sum_.reset();
+      sq_.reset();
+    }
+
+    inline long count() const { return n_; }
+    inline T sum() const { return sum_.value(); }
+    inline T mean() const { return sum_.value() / n_; }
+
+    inline T variance() const { // sample variance; requires count() > 1
+      const T s = sum_.value();
+      const T v = (sq_.value() - (s * s) / n_) / (n_ - 1);
+      return (v < 0) ? 0 : v; // never below zero through rounding
+    }
+
+  private:
+    long n_;
+    NeumaierSum<T> sum_;
+    NeumaierSum<T> sq_;
+    bool claimed_;
+  };
+
+} // namespace Signal
+
+#endif // _RUNNING_MOMENTS_HPP
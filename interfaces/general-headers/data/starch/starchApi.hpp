@@ -32,6 +32,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 #else
 #include <inttypes.h>
 #include <stdint.h>
@@ -68,6 +70,7 @@ namespace starch
 
             int listJSONMetadata(FILE *out, FILE *err);
             bool extractBEDLine(std::string& line);
+            bool extractBEDElement(const char*& chr, Bed::SignedCoordType& start, Bed::SignedCoordType& stop, const char*& rest);
             int extractAllData(const std::string& chr, FILE *out);
 
             static bool fnExists(const std::string& _inFn) 
@@ -726,6 +729,7 @@ namespace starch
         bool                            getCurrentChromosomeHasNestedElement() { return (archMdIter) ? (archMdIter->nestedElementExists == kStarchTrue ? true : false ) : (STARCH_DEFAULT_NESTED_ELEMENT_FLAG_VALUE == kStarchTrue ? true : false ); }
         bool                            getAllChromosomesHaveDuplicateElement() { Metadata *_archMdIter; for (_archMdIter = archMd; _archMdIter != NULL; _archMdIter = _archMdIter->next) { if (UNSTARCH_duplicateElementExistsForChromosome(archMd, _archMdIter->chromosome) == kStarchTrue) return true; } return false; }
         bool                            getAllChromosomesHaveNestedElement() { Metadata *_archMdIter; for (_archMdIter = archMd; _archMdIter != NULL; _archMdIter = _archMdIter->next) { if (UNSTARCH_nestedElementExistsForChromosome(archMd, _archMdIter->chromosome) == kStarchTrue) return true; } return false; }
+        std::vector<std::string>        getChromosomes() { std::vector<std::string> _chrs; Metadata *_archMdIter; for (_archMdIter = archMd; _archMdIter != NULL; _archMdIter = _archMdIter->next) { _chrs.push_back(_archMdIter->chromosome); } return _chrs; }
         inline bool                     isEOF() { return (!getCurrentChromosome()); }
         inline bool                     isSpecialLine(const char * buf) {
             return (std::strncmp(buf, kStarchBedHeaderTrack, strlen(kStarchBedHeaderTrack)) == 0 ||
@@ -750,6 +754,8 @@ namespace starch
         json_t *archMdJSON;
         Metadata *archMdIter;
         bool firstPass;
+        bool elementReady;
+        std::string elementRest;
         FILE *inFp;
         std::string inFn;
         std::string selectedChromosome;
@@ -797,7 +803,8 @@ namespace starch
         int seekCurrentInFpPosition();
         int zReadChunk();
         int zReadLine();
-        int extractLine(std::string& line);
+        int extractLine(std::string& line, bool format = true);
+        bool extractElement(std::string& line, bool format);
         int setupPerLineAccess();
         int readJSONMetadata(bool suppressErrorMsgs, bool preserveJSONRef);
         
@@ -1117,6 +1124,7 @@ namespace starch
         std::fprintf(stderr, "\n--- Starch::initializeMembers() ---\n");
 #endif
         firstPass = true;
+        elementReady = false;
         selectedChromosome = "";
         archMd = NULL;
         archVersion = NULL;
@@ -1448,7 +1456,37 @@ namespace starch
         std::fprintf(stderr, "\n--- Starch::extractBEDLine(std::string &) ---\n");
 #endif
 
+        return extractElement(line, true);
+    }
+
+    /*
+        The next element without printing it as a line of text for the caller
+        to parse back: chr, start and stop as decoded, and rest holding the
+        columns after stop, each with the tab ahead of it, or "" when there
+        are none.  The pointers are good until the next extract call.  chr is
+        NULL when extractBEDLine() would have given back an empty line.
+    */
+
+    bool
+    Starch::extractBEDElement(const char*& chr, Bed::SignedCoordType& start, Bed::SignedCoordType& stop, const char*& rest)
+    {
+#ifdef DEBUG
+        std::fprintf(stderr, "\n--- Starch::extractBEDElement(...) ---\n");
+#endif
+
+        const bool res = extractElement(elementRest, false);
+        chr = (elementReady) ? _currChr : NULL;
+        start = _currStart;
+        stop = _currStop;
+        rest = elementRest.c_str();
+        return res;
+    }
+
+    bool
+    Starch::extractElement(std::string& line, bool format)
+    {
         line.clear();
+        elementReady = false;
         while (!isEOF()) {
 #ifdef DEBUG
             std::fprintf(stderr, "--> not isEOF()\n");
@@ -1477,7 +1515,7 @@ namespace starch
 #ifdef DEBUG
                     std::fprintf(stderr, "--> firstPass is true or line is empty, calling extractLine() again\n");
 #endif
-                    extractLine(line);
+                    extractLine(line, format);
                     firstPass = false;
                 }
 
@@ -1485,16 +1523,16 @@ namespace starch
 #ifdef DEBUG
                     std::fprintf(stderr, "--> prefix is 'p'\n");
 #endif
-                    extractLine(line);
+                    extractLine(line, format);
                 }
-                else if (!line.empty()) {
+                else if (elementReady) {
 #ifdef DEBUG
                     std::fprintf(stderr, "--> line is not empty, therefore break [ %s ]\n", line.c_str());
 #endif
                     firstPass = true;
                     break;
                 }
-                else if (!firstPass && line.empty()) {
+                else if (!firstPass && !elementReady) {
                     break;
                 }
             }
@@ -1507,14 +1545,19 @@ namespace starch
         return !isEOF();
     }
 
+    /*
+        format: line gets the element as a line of BED text; otherwise it gets
+        only the columns after stop, tabs included, as extractBEDElement() gives.
+        elementReady says whether an element was extracted at all.
+    */
+
     int
-    Starch::extractLine(std::string& line)
+    Starch::extractLine(std::string& line, bool format)
     { 
 #ifdef DEBUG
-        std::fprintf(stderr, "\n--- Starch::extractLine(std::string &) ---\n");
+        std::fprintf(stderr, "\n--- Starch::extractLine(std::string &, bool) ---\n");
 #endif
 
-        static char out[STARCH_BUFFER_MAX_LENGTH];
         static const char tab = '\t';
         int res = 0;
 
@@ -1604,7 +1647,7 @@ namespace starch
 #endif
 
                         if (t_firstInputToken[0] == 'p')
-                            extractLine(line);
+                            extractLine(line, format);
 
                         t_firstInputToken[0] = '\0';
                         t_secondInputToken[0] = '\0';
@@ -1623,6 +1666,7 @@ namespace starch
                             if (_currChr) free(_currChr), _currChr = NULL;
                             if (_currRemainder) free(_currRemainder), _currRemainder = NULL;
                             line.clear();
+                            elementReady = false;
                             return EXIT_SUCCESS;
                         }
                         iterateArchiveMdIter();
@@ -1632,6 +1676,7 @@ namespace starch
                             if (currentRemainder) free(currentRemainder), currentRemainder = NULL;
                             if (_currChr) free(_currChr), _currChr = NULL;
                             line.clear();
+                            elementReady = false;
                             return EXIT_SUCCESS;
                         }
                         seekCurrentInFpPosition();
@@ -1641,7 +1686,7 @@ namespace starch
                         // BED element (we're not interested in untransformed data, but
                         // in a fully-transformed line of BED output)
 
-                        extractLine(line);
+                        extractLine(line, format);
                     }
                     break;
                 }
@@ -1739,7 +1784,7 @@ namespace starch
                         // once again to get actual BED output
 
                         if (t_firstInputToken[0] == 'p')
-                            extractLine(line);
+                            extractLine(line, format);
 
                         t_firstInputToken[0] = '\0';
                         t_secondInputToken[0] = '\0';
@@ -1764,6 +1809,7 @@ namespace starch
                             if (_currChr) free(_currChr), _currChr = NULL;
                             if (_currRemainder) free(_currRemainder), _currRemainder = NULL;
                             line.clear();
+                            elementReady = false;
                             return EXIT_SUCCESS;
                         }
                         iterateArchiveMdIter();
@@ -1776,6 +1822,7 @@ namespace starch
                             if (currentRemainder) free(currentRemainder), currentRemainder = NULL;
                             if (_currChr) free(_currChr), _currChr = NULL;
                             line.clear();
+                            elementReady = false;
 #ifdef DEBUG_VERBOSE
                             std::fprintf(stderr, "--> returning...\n");
 #endif
@@ -1790,7 +1837,7 @@ namespace starch
 #ifdef DEBUG_VERBOSE
                         std::fprintf(stderr, "--> calling extractLine() one more time...\n");
 #endif
-                        extractLine(line);
+                        extractLine(line, format);
                     }
                     break;
                 }
@@ -1810,13 +1857,25 @@ namespace starch
                 setCurrentRemainder(_currRemainder);
             }
 
-            if (_currRemainder && (_currRemainderLen > 0)) {
-                std::sprintf(out, "%s\t%" PRId64 "\t%" PRId64 "\t%s", _currChr, _currStart, _currStop, _currRemainder);
+            if (!format) {
+                line.clear();
+                if (_currRemainder && (_currRemainderLen > 0)) {
+                    line += tab;
+                    line += _currRemainder;
+                }
             }
             else {
-                std::sprintf(out, "%s\t%" PRId64 "\t%" PRId64, _currChr, _currStart, _currStop);
+                // built in the caller's string: no line-sized buffer per thread
+                char coords[48];
+                int coordsLen = std::snprintf(coords, sizeof(coords), "\t%" PRId64 "\t%" PRId64, _currStart, _currStop);
+                line.assign(_currChr);
+                line.append(coords, static_cast<std::size_t>(coordsLen));
+                if (_currRemainder && (_currRemainderLen > 0)) {
+                    line += tab;
+                    line += _currRemainder;
+                }
             }
-            line = out;
+            elementReady = true;
 
             if (archType == kGzip)
                 postBreakdownZValuesIdentical = (zOutBufIdx == zHave);
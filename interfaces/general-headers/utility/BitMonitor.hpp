@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <ostream>
@@ -167,6 +169,118 @@ namespace Ext {
     return os;
   }
 
+  namespace Details {
+    inline std::size_t lowbit64(std::uint64_t v) { // v != 0
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(v));
+#else
+      std::size_t i = 0;
+      for ( ; !(v & 1); v >>= 1 )
+        ++i;
+      return i;
+#endif
+    }
+
+    /*
+      OpenBits<Bits> : Bits slots in 64-bit words.  Past one word, a nested
+        OpenBits over the words marks those that are full, so finding an open
+        slot is one trailing-zero count per level.  4096 slots or fewer means
+        a single summary word.  Unused bits of a short word read as set.
+      open_near(b) is the lowest open slot in the smallest aligned group of 8,
+        64, 512, ... slots around b that has one: the order in which the old
+        byte-per-level BitMonitor2 handed slots out.
+    */
+    constexpr std::size_t NoBit = std::numeric_limits<std::size_t>::max();
+
+    template <std::size_t Bits, bool OneWord=(Bits<=64)>
+    struct OpenBits;
+
+    template <std::size_t Bits>
+    struct OpenBits<Bits, true> {
+      static constexpr std::size_t NWORDS = 1;
+      static constexpr std::uint64_t PAD = (Bits == 64) ? 0 : (~std::uint64_t(0) << (Bits%64));
+
+      OpenBits() : _w(PAD) { }
+
+      inline bool any() const { return _w != ~std::uint64_t(0); }
+      inline std::size_t open_near(std::size_t bit) const {
+        const std::uint64_t o = ~_w;
+        const std::size_t g = bit & ~std::size_t(7);
+        if ( (o >> g) & 0xff )
+          return g + lowbit64(o >> g);
+        return o ? lowbit64(o) : NoBit;
+      }
+      inline bool set(std::size_t bit) { _w |= (std::uint64_t(1) << bit); return any(); }
+      inline void unset(std::size_t bit) { _w &= ~(std::uint64_t(1) << bit); }
+      inline void set_all() { _w = ~std::uint64_t(0); }
+      inline void unset_all() { _w = PAD; }
+      inline std::uint64_t word(std::size_t) const { return _w & ~PAD; }
+
+      std::uint64_t _w;
+    };
+
+    template <std::size_t Bits>
+    struct OpenBits<Bits, false> {
+      static_assert(Bits%64 == 0, "OpenBits: more than 64 slots must fill whole words");
+      static constexpr std::size_t NWORDS = Bits/64;
+
+      OpenBits() : _w{} { }
+
+      inline bool any() const { return _full.any(); }
+
+      inline std::size_t open_near(std::size_t bit) const {
+        std::size_t i = bit/64;
+        const std::uint64_t o = ~_w[i];
+        const std::size_t g = bit%64 & ~std::size_t(7);
+        if ( (o >> g) & 0xff )
+          return i*64 + g + lowbit64(o >> g);
+        if ( o )
+          return i*64 + lowbit64(o);
+        if ( (i = _full.open_near(i)) == NoBit )
+          return NoBit;
+        return i*64 + lowbit64(~_w[i]);
+      }
+
+      inline bool set(std::size_t bit) {
+        const std::size_t i = bit/64;
+        _w[i] |= (std::uint64_t(1) << (bit%64));
+        if ( _w[i] != ~std::uint64_t(0) )
+          return true;
+        return _full.set(i);
+      }
+
+      inline void unset(std::size_t bit) {
+        const std::size_t i = bit/64;
+        _w[i] &= ~(std::uint64_t(1) << (bit%64));
+        _full.unset(i);
+      }
+
+      inline void set_all() {
+        for ( auto& w : _w )
+          w = ~std::uint64_t(0);
+        _full.set_all();
+      }
+
+      inline void unset_all() {
+        for ( auto& w : _w )
+          w = 0;
+        _full.unset_all();
+      }
+
+      inline std::uint64_t word(std::size_t i) const { return _w[i]; }
+
+      std::uint64_t _w[NWORDS];
+      OpenBits<NWORDS> _full;
+    };
+  } // namespace Details
+
+  //=============
+  // BitMonitor2 : which of Total slots are taken.  get_open() needs any() to be
+  //                true and gives the slot released last, else the one nearest
+  //                the slot taken last.  Pool addresses, and so the order some
+  //                visitors see ties in, depend on that order.
+  //               set() says whether any slot is still open afterwards.
+  //=============
   template <std::size_t Base,
             std::size_t Total, // undefined when Check==false
             bool Check=(Base==std::numeric_limits<unsigned char>::digits) &&
@@ -178,158 +292,62 @@ namespace Ext {
             std::size_t Total>
   struct BitMonitor2<Base, Total, true> {
     static constexpr std::size_t BASE = std::numeric_limits<unsigned char>::digits;
-    static constexpr std::size_t TOTAL = Total + BitMonitor2<Base, Total/Base>::TOTAL;
     static constexpr std::size_t BITS = Total;
     static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
-    BitMonitor2() : _nxt(0) { for( std::size_t i=0; i<TBYTE; ++i) _charset[i]=CZERO; }
-    inline bool any() const { return _charset[LAST_BYTE] != FULL; }
+    BitMonitor2() : _nxt(0) { }
+
+    inline bool any() const { return _bits.any(); }
     inline std::size_t get_open() const { return _nxt; }
     inline std::size_t size() const { return BITS; }
 
     inline bool set(std::size_t bit) {
-      std::size_t bin = bit/BASE;
-      _charset[bin] |= (1 << (bit%BASE));
-      if ( _charset[bin] != FULL ) {
-        if ( bit == _nxt ) {
-          for ( std::size_t i = 0; i < BASE; ++i ) {
-            if ( !(_charset[bin] & (1 << i)) ) {
-              _nxt = BASE*bin+i;
-              break;
-            }
-          } // for
-        }
-        return true;
-      }
-
-      std::size_t idx = BITS;
-      std::size_t val = bin; // val == bit/BASE
-      bin = BITS;
-      std::size_t parent = (bin + val);
-      std::size_t pbyte = parent/BASE;
-      while ( parent < TOTAL ) {
-        _charset[pbyte] |= (1 << (val%BASE));
-        if ( _charset[pbyte] != FULL ) {
-          if ( _nxt != bit )
-            return true;
-          _nxt = npos;
-          for ( std::size_t i = 0; i < BASE; ++i ) {
-            if ( !(_charset[pbyte] & (1 << i)) ) {
-              _nxt = find_open_child(pbyte*BASE+i);
-              break;
-            }
-          } // for
-          return true;
-        }
-        idx /= BASE;
-        bin += idx;
-        val /= BASE;
-        parent = bin + val;
-        pbyte = parent/BASE;
-      } // while
-      return false;
+      const bool open = _bits.set(bit);
+      if ( bit == _nxt )
+        _nxt = open ? _bits.open_near(bit) : npos;
+      return open;
     }
 
     inline void set_all() {
-      for ( auto& c : _charset )
-        c = FULL;
+      _bits.set_all();
       _nxt = npos;
     }
 
     inline void unset(std::size_t bit) {
-      std::size_t bin = bit/BASE;
-      bool pstatus = _charset[bin] != FULL;
-      _charset[bin] &= ~(1 << (bit%BASE));
+      _bits.unset(bit);
       _nxt = bit;
-      if ( pstatus ) // parent wasn't FULL even before unsetting bit
-        return;
-
-      // unset parent from FULL
-      std::size_t parent_bit = BITS + bin; // bin=bit/BASE
-      _charset[parent_bit/BASE] &= ~(1 << (parent_bit%BASE));
-
-      std::size_t val = BITS/BASE;
-      std::size_t idx = BITS + val;
-      bin /= BASE;
-      while ( !pstatus && (parent_bit = idx + bin) < TOTAL ) {
-        if ( _charset[parent_bit/BASE] != FULL )
-          pstatus = true;
-        _charset[parent_bit/BASE] &= ~(1 << (parent_bit%BASE));
-        val /= BASE;
-        idx += val;
-        bin /= BASE;
-      } // while
     }
 
     inline void unset_all() {
-      for ( auto& c : _charset )
-        c = CZERO;
+      _bits.unset_all();
       _nxt = 0;
     }
 
     inline std::size_t next_set(std::size_t start, std::size_t end = BITS, bool include_start = false) const {
-      std::size_t beg = (start + !include_start);
-      std::size_t bin = beg/BASE;
-      for ( std::size_t i = beg%BASE; i < BASE; ++i ) {
-        if (_charset[bin] & (1 << i))
-          return bin*BASE+i;
-      } // for
-
-      for ( std::size_t b = bin+1; b <= end/BASE; ++b ) {
-        if ( _charset[b] ) {
-          for ( std::size_t i = 0; i < BASE; ++i ) {
-            if ( _charset[b] & (1 << i) )
-              return b*BASE+i;
-          } // for
-        }
-      } // for
-      return npos;
+      return scan<false>(start + !include_start, (end < BITS) ? end : BITS);
     }
 
     inline std::size_t next_unset(std::size_t start, bool include_start = false) const {
-      std::size_t beg = (start + !include_start);
-      std::size_t bin = beg/BASE;
-      for ( std::size_t i = beg%BASE; i < BASE; ++i ) {
-        if ( !(_charset[bin] & (1 << i)) )
-          return bin*BASE+i;
-      } // for
-
-      for ( std::size_t b = bin+1; b <= BITS/BASE; ++b ) {
-        if ( _charset[b] != FULL ) {
-          for ( std::size_t i = 0; i < BASE; ++i ) {
-            if ( !(_charset[b] & (1 << i)) )
-              return b*BASE+i;
-          } // for
-        }
-      } // for
-      return npos;
+      return scan<true>(start + !include_start, BITS);
     }
 
   private:
-    inline std::size_t find_open_child(std::size_t p) {
-      while ( BITS <= p ) {
-        std::size_t isum = BITS;
-        std::size_t inow = BITS;
-        std::size_t itrail = 0, ptrail = 0;
-        while ( isum < p ) {
-          inow /= BASE;
-          ptrail = itrail;
-          itrail = isum;
-          isum += inow;
-        } // while
-        if ( isum > p ) { isum = itrail; itrail = ptrail; }
-        p -= isum;
-        p *= BASE;
-        p += itrail;
-        std::size_t pbyte = p/BASE;
-        for ( std::size_t i = 0; i < BASE; ++i ) {
-          if ( !(_charset[pbyte] & (1 << i)) ) {
-            p += i;
-            break;
-          }
-        } // for
+    // first set (or open) slot in [beg, end)
+    template <bool Open>
+    inline std::size_t scan(std::size_t beg, std::size_t end) const {
+      if ( beg >= end )
+        return npos;
+      std::size_t i = beg/64;
+      std::uint64_t w = (Open ? ~_bits.word(i) : _bits.word(i)) & (~std::uint64_t(0) << (beg%64));
+      while ( true ) {
+        if ( w ) {
+          const std::size_t pos = i*64 + Details::lowbit64(w);
+          return (pos < end) ? pos : npos;
+        }
+        if ( (++i)*64 >= end )
+          return npos;
+        w = Open ? ~_bits.word(i) : _bits.word(i);
       } // while
-      return p;
     }
 
     template <std::size_t A, std::size_t B, bool C>
@@ -338,24 +356,15 @@ namespace Ext {
     operator<<(std::ostream& os, const BitMonitor2<A,B,C>& r);
 
   private:
-    static constexpr unsigned char FULL = std::numeric_limits<unsigned char>::max();
-    static constexpr unsigned char CZERO = (unsigned char)0;
-    static constexpr std::size_t TBYTE = TOTAL/BASE;
-    static constexpr std::size_t LAST_BYTE = TBYTE-1;
     std::size_t _nxt;
-    std::array<unsigned char, TBYTE> _charset;
-  };
-
-  template <std::size_t Base>
-  struct BitMonitor2<Base, Base, true> {
-    static constexpr std::size_t BASE = Base;
-    static constexpr std::size_t TOTAL = Base;
+    Details::OpenBits<Total> _bits;
   };
 
   template <std::size_t A, std::size_t B, bool C>
   typename std::enable_if<C, std::ostream&>::type
   operator<<(std::ostream& os, const BitMonitor2<A,B,C>& r) {
-    std::copy(r._charset.begin(), r._charset.end(), std::ostream_iterator<std::bitset<8>>(os, " "));
+    for ( std::size_t i = 0; i < (B+63)/64; ++i )
+      os << std::bitset<64>(r._bits.word(i)) << " ";
     os << std::endl;
     return os;
   }
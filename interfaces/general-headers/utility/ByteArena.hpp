@@ -0,0 +1,225 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 07:05:28 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef UTILS_BYTE_ARENA_HPP
+#define UTILS_BYTE_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace Ext {
+
+  //===========
+  // ByteArena : per-thread bump allocation out of BlockSize-aligned blocks.
+  //              Each block counts the spans that refer to it (plus one while
+  //              it is the thread's current block) and goes back to the heap
+  //              when the count drops to zero, from whichever thread drops it.
+  //              Records that are read, held in a sweep window and released
+  //              in roughly input order free their blocks in that order too.
+  //             A request too large for a block gets a block of its own, which
+  //              is never reused.
+  //===========
+  struct ByteArena {
+    static constexpr std::size_t BlockSize = 16384;
+
+    // n > 0 bytes, with one reference held by the caller
+    static char* alloc(std::size_t n) {
+      State& t = state();
+      if ( n > static_cast<std::size_t>(t.end_ - t.cur_) ) {
+        if ( n > BlockSize - sizeof(Header) )
+          return make(sizeof(Header) + n, 1, true);
+        if ( t.cur_ )
+          release(t.cur_ - 1);
+        char* b = block(t); // the arena's reference and the caller's
+        t.cur_ = b + n;
+        t.end_ = b - sizeof(Header) + BlockSize;
+        return b;
+      }
+      header(t.cur_)->refs_.fetch_add(1, std::memory_order_relaxed);
+      char* b = t.cur_;
+      t.cur_ += n;
+      return b;
+    }
+
+    static inline void retain(char const* p) {
+      if ( p )
+        header(p)->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static inline void release(char const* p) {
+      if ( p ) {
+        Header* h = header(p);
+        if ( h->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+          recycle(h);
+      }
+    }
+
+  private:
+    struct alignas(16) Header {
+      std::atomic<std::uint32_t> refs_;
+      bool oversize_;
+      Header* next_; // while spare
+    };
+
+    // a sweep window frees blocks about as fast as it fills them, so a few
+    //  empty ones are kept back rather than handed to posix_memalign() again
+    static constexpr std::size_t MaxSpares = 8;
+
+    struct State {
+      State() : cur_(nullptr), end_(nullptr), spares_(nullptr), nspares_(0) { /* */ }
+      ~State() {
+        if ( cur_ )
+          release(cur_ - 1);
+        gone() = true;
+        while ( spares_ ) {
+          Header* h = spares_;
+          spares_ = h->next_;
+          std::free(h);
+        } // while
+      }
+      char* cur_;
+      char* end_;
+      Header* spares_;
+      std::size_t nspares_;
+    };
+
+    static inline State& state() {
+      static thread_local State t;
+      return t;
+    }
+
+    // true once this thread's State is destroyed.  Records still held then (by a
+    //  static pool, at exit) are released later; a bool has no destructor, so
+    //  this stays readable where State's members no longer are.
+    static inline bool& gone() {
+      static thread_local bool g = false;
+      return g;
+    }
+
+    // p lies in the first BlockSize bytes of its block, which is BlockSize-aligned
+    static inline Header* header(char const* p) {
+      return reinterpret_cast<Header*>(reinterpret_cast<std::uintptr_t>(p) & ~std::uintptr_t(BlockSize - 1));
+    }
+
+    static char* make(std::size_t sz, std::uint32_t refs, bool oversize) {
+      void* m = nullptr;
+      if ( posix_memalign(&m, BlockSize, sz) != 0 )
+        throw std::bad_alloc();
+      Header* h = new (m) Header;
+      h->refs_.store(refs, std::memory_order_relaxed);
+      h->oversize_ = oversize;
+      h->next_ = nullptr;
+      return static_cast<char*>(m) + sizeof(Header);
+    }
+
+    static char* block(State& t) {
+      if ( !t.spares_ )
+        return make(BlockSize, 2, false);
+      Header* h = t.spares_;
+      t.spares_ = h->next_;
+      --t.nspares_;
+      h->refs_.store(2, std::memory_order_relaxed);
+      return reinterpret_cast<char*>(h) + sizeof(Header);
+    }
+
+    // the last reference to h is gone; a block freed after this thread's
+    //  state has been torn down goes straight back to the heap
+    static void recycle(Header* h) {
+      if ( h->oversize_ || gone() || state().nspares_ == MaxSpares ) { // gone(): state() is not to be touched
+        h->~Header();
+        std::free(h);
+        return;
+      }
+      State& t = state();
+      h->next_ = t.spares_;
+      t.spares_ = h;
+      ++t.nspares_;
+    }
+  };
+
+  //=============
+  // ArenaString : immutable, '\0'-terminated text in a ByteArena.  Copies share
+  //                the bytes; assign() and reset() always take fresh ones.
+  //=============
+  class ArenaString {
+  public:
+    ArenaString() : p_(nullptr) { /* */ }
+    ArenaString(const ArenaString& a) : p_(a.p_) { ByteArena::retain(p_); }
+    ArenaString(ArenaString&& a) : p_(a.p_) { a.p_ = nullptr; }
+
+    ArenaString& operator=(const ArenaString& a) {
+      ByteArena::retain(a.p_);
+      ByteArena::release(p_);
+      p_ = a.p_;
+      return *this;
+    }
+    ArenaString& operator=(ArenaString&& a) {
+      std::swap(p_, a.p_);
+      return *this;
+    }
+
+    inline char const* c_str() const { return p_ ? p_ : ""; }
+    inline bool empty() const { return !p_; }
+
+    inline void clear() {
+      ByteArena::release(p_);
+      p_ = nullptr;
+    }
+
+    // n writable bytes, already terminated at [n], for the caller to fill
+    inline char* reset(std::size_t n) {
+      clear();
+      if ( n == 0 )
+        return nullptr;
+      p_ = ByteArena::alloc(n + 1);
+      p_[n] = '\0';
+      return p_;
+    }
+
+    // s may point into this string's own bytes
+    inline void assign(char const* s, std::size_t n) {
+      char* d = nullptr;
+      if ( n != 0 ) {
+        d = ByteArena::alloc(n + 1);
+        std::memcpy(d, s, n);
+        d[n] = '\0';
+      }
+      ByteArena::release(p_);
+      p_ = d;
+    }
+    inline void assign(char const* s) { assign(s, std::strlen(s)); }
+
+    ~ArenaString() { ByteArena::release(p_); }
+
+  private:
+    char* p_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_BYTE_ARENA_HPP
@@ -0,0 +1,185 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 10:17:51 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#ifndef UTILS_CONCURRENT_SMALLOBJ_MEM
+#define UTILS_CONCURRENT_SMALLOBJ_MEM
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "utility/PooledMemory.hpp"
+
+namespace Ext {
+
+  //========================
+  // ConcurrentPooledMemory : a drop-in for PooledMemory that may be shared by
+  //                           threads.  Each thread constructs out of a heap of
+  //                           its own (a PooledMemory: its magazine of chunks),
+  //                           found through a small thread_local cache, so the
+  //                           common path takes no lock and no atomic RMW.
+  //                          release() from the thread that built an object is
+  //                           the plain PooledMemory release.  From any other
+  //                           thread the object is destroyed there and its slot
+  //                           is pushed onto the owning heap's lock-free stack;
+  //                           the owner takes the whole stack back the next time
+  //                           it constructs.
+  //                          Heaps live as long as the pool.  Slots freed to a
+  //                           heap whose thread has exited are reclaimed when a
+  //                           thread with the same id picks that heap up again,
+  //                           or at the latest when the pool is destroyed, which
+  //                           must not happen while other threads still use it.
+  //========================
+  template <typename DataType, std::size_t chunksz = 512>
+  struct ConcurrentPooledMemory {
+    typedef DataType type;
+
+    ConcurrentPooledMemory() : _serial(next_serial()), _heaps(nullptr)
+      { }
+
+    ConcurrentPooledMemory(const ConcurrentPooledMemory&) = delete;
+    ConcurrentPooledMemory& operator=(const ConcurrentPooledMemory&) = delete;
+
+    template <typename... Args>
+    inline
+    type* construct(Args... parameters) {
+      Heap* h = local();
+      if ( h->_remote.load(std::memory_order_relaxed) )
+        h->drain();
+      return h->construct(parameters...);
+    }
+
+    inline
+    void release(type* b) {
+      Heap* h = static_cast<Heap*>(Pool::pool_of(b));
+      if ( h->_id == std::this_thread::get_id() )
+        h->release(b);
+      else {
+        b->~type();
+        h->push(b);
+      }
+    }
+
+    ~ConcurrentPooledMemory() {
+      while ( _heaps ) {
+        Heap* h = _heaps;
+        _heaps = h->_next;
+        h->drain(); // those slots hold no objects anymore
+        delete h;
+      } // while
+    }
+
+  private:
+    typedef PooledMemory<type, chunksz> Pool;
+
+    struct Link { Link* _next; }; // overlays a released slot
+
+    static_assert(sizeof(type) >= sizeof(Link) && alignof(type) >= alignof(Link),
+                  "ConcurrentPooledMemory: a slot must be able to hold a pointer");
+
+    struct Heap : Pool {
+      Heap(std::thread::id id, Heap* next) : _remote(nullptr), _id(id), _next(next)
+        { }
+
+      // any thread
+      inline void push(type* b) {
+        Link* l = new (static_cast<void*>(b)) Link;
+        l->_next = _remote.load(std::memory_order_relaxed);
+        while ( !_remote.compare_exchange_weak(l->_next, l, std::memory_order_release, std::memory_order_relaxed) )
+          ;
+      }
+
+      // owning thread only
+      inline void drain() {
+        Link* l = _remote.exchange(nullptr, std::memory_order_acquire);
+        while ( l ) {
+          Link* n = l->_next;
+          this->reclaim(reinterpret_cast<type*>(l));
+          l = n;
+        } // while
+      }
+
+      std::atomic<Link*> _remote;
+      const std::thread::id _id;
+      Heap* _next;
+    };
+
+    // per thread, the heaps of the last few pools it used; serials are never
+    //  reused, so an entry left behind by a destroyed pool simply never matches
+    struct Cache {
+      std::uint64_t _serial;
+      Heap* _heap;
+    };
+    static constexpr std::size_t NCache = 4;
+
+    inline Heap* local() {
+      static thread_local Cache cache[NCache] = {};
+      for ( std::size_t i = 0; i < NCache; ++i ) {
+        if ( cache[i]._serial == _serial )
+          return cache[i]._heap;
+      } // for
+
+      Heap* h = find_or_add();
+      for ( std::size_t i = NCache-1; i > 0; --i )
+        cache[i] = cache[i-1];
+      cache[0]._serial = _serial;
+      cache[0]._heap = h;
+      return h;
+    }
+
+    Heap* find_or_add() {
+      const std::thread::id id = std::this_thread::get_id();
+      std::lock_guard<std::mutex> lock(_mtx);
+      for ( Heap* h = _heaps; h; h = h->_next ) {
+        if ( h->_id == id )
+          return h;
+      } // for
+      _heaps = new Heap(id, _heaps);
+      return _heaps;
+    }
+
+    static std::uint64_t next_serial() {
+      static std::atomic<std::uint64_t> serial(0);
+      return ++serial;
+    }
+
+    const std::uint64_t _serial;
+    std::mutex _mtx; // guards _heaps
+    Heap* _heaps;
+  };
+
+  // pools whose objects may be released on a thread other than the one that built them
+  template <typename PoolType>
+  struct is_concurrent_pool : std::false_type { };
+
+  template <typename DataType, std::size_t chunksz>
+  struct is_concurrent_pool<ConcurrentPooledMemory<DataType, chunksz>> : std::true_type { };
+
+} // namespace Ext
+
+#endif // UTILS_CONCURRENT_SMALLOBJ_MEM
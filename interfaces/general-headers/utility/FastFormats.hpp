@@ -0,0 +1,189 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 08:38:46 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef FAST_C_FORMATS_H
+#define FAST_C_FORMATS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "utility/Formats.hpp"
+
+/*
+  Fast paths for reading and writing doubles, giving the same bytes as strtod() and
+    printf("%.*f") in the "C" locale, which is the only one these programs run in.
+  Reading: a plain decimal with at most 19 significant digits and a power of ten
+    within 10^22 converts exactly with one multiply or divide (Clinger's fast path),
+    since both operands are exact doubles and IEEE rounds the result once.  Anything
+    else (more digits, big exponents, hex, inf, nan) goes to strtod().
+  Writing: v * 10^prec picks up at most half an ulp of error.  Unless that error
+    could straddle a rounding boundary, rounding it to an integer gives exactly what
+    printf() prints; otherwise, and for large values, snprintf() does the work.
+*/
+
+namespace Formats {
+
+  namespace Details {
+    inline double pow10(int e) { // 0 <= e <= 22 : exact
+      static const double p[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      return p[e];
+    }
+
+    inline bool isdigit(char c) { return static_cast<unsigned char>(c - '0') <= 9; }
+  } // namespace Details
+
+  // strtod(p, end), bit for bit
+  inline double ParseDouble(char const* p, char** end) {
+    char const* q = p;
+    const bool neg = (*q == '-');
+    if ( neg || *q == '+' )
+      ++q;
+    if ( q[0] == '0' && (q[1] == 'x' || q[1] == 'X') )
+      return std::strtod(p, end);
+
+    std::uint64_t m = 0;
+    int digits = 0, exp10 = 0;
+    bool any = false;
+    for ( ; Details::isdigit(*q); ++q, any = true ) {
+      if ( m == 0 && *q == '0' )
+        continue; // leading zeros are not significant
+      if ( ++digits > 19 )
+        return std::strtod(p, end);
+      m = m * 10 + static_cast<std::uint64_t>(*q - '0');
+    } // for
+    if ( *q == '.' ) {
+      ++q;
+      for ( ; Details::isdigit(*q); ++q, any = true ) {
+        if ( m == 0 && *q == '0' ) {
+          --exp10;
+          continue;
+        }
+        if ( ++digits > 19 )
+          return std::strtod(p, end);
+        m = m * 10 + static_cast<std::uint64_t>(*q - '0');
+        --exp10;
+      } // for
+    }
+    if ( !any ) // inf, nan, or not a number at all
+      return std::strtod(p, end);
+
+    if ( *q == 'e' || *q == 'E' ) {
+      char const* e = q + 1;
+      const bool eneg = (*e == '-');
+      if ( eneg || *e == '+' )
+        ++e;
+      if ( Details::isdigit(*e) ) { // else the 'e' is not part of the number
+        int x = 0;
+        for ( ; Details::isdigit(*e); ++e ) {
+          if ( x > 1000 )
+            return std::strtod(p, end);
+          x = x * 10 + (*e - '0');
+        } // for
+        exp10 += eneg ? -x : x;
+        q = e;
+      }
+    }
+
+    if ( m > (std::uint64_t(1) << 53) || exp10 < -22 || exp10 > 22 ) {
+      if ( m != 0 )
+        return std::strtod(p, end);
+      exp10 = 0; // zero, whatever the exponent
+    }
+
+    double v = static_cast<double>(m);
+    if ( exp10 < 0 )
+      v /= Details::pow10(-exp10);
+    else
+      v *= Details::pow10(exp10);
+    if ( end )
+      *end = const_cast<char*>(q);
+    return neg ? -v : v;
+  }
+
+  // snprintf(buf, sz, "%.*f", prec, v), bit for bit; returns the length, as snprintf() does
+  inline int PrintDouble(char* buf, std::size_t sz, double v, int prec) {
+    const double ax = std::fabs(v);
+    if ( prec < 0 || prec > 17 || !(ax < 1e15) || sz < 40 )
+      return std::snprintf(buf, sz, "%.*f", prec, v);
+
+    const double x = ax * Details::pow10(prec);
+    if ( x >= 4503599627370496.0 ) // 2^52
+      return std::snprintf(buf, sz, "%.*f", prec, v);
+    const double fl = std::floor(x);
+    const double frac = x - fl; // exact
+    const double err = x * 2.220446049250313e-16 + 1e-300; // 2^-52 : twice the product's error
+    if ( std::fabs(frac - 0.5) <= err )
+      return std::snprintf(buf, sz, "%.*f", prec, v);
+    std::uint64_t n = static_cast<std::uint64_t>(fl) + (frac > 0.5);
+
+    char digits[24];
+    int nd = 0;
+    do {
+      digits[nd++] = static_cast<char>('0' + n % 10);
+      n /= 10;
+    } while ( n );
+    while ( nd <= prec ) // at least one digit before the point
+      digits[nd++] = '0';
+
+    char* b = buf;
+    if ( std::signbit(v) )
+      *b++ = '-';
+    while ( nd > prec )
+      *b++ = digits[--nd];
+    if ( prec > 0 ) {
+      *b++ = '.';
+      while ( nd > 0 )
+        *b++ = digits[--nd];
+    }
+    *b = '\0';
+    return static_cast<int>(b - buf);
+  }
+
+  // what printf(Format(v)) prints, into buf; the length as snprintf() returns it
+  template <typename T>
+  inline int PrintNumber(char* buf, std::size_t sz, T v) {
+    return std::snprintf(buf, sz, Format(v), v);
+  }
+
+  inline int PrintNumber(char* buf, std::size_t sz, double v) { // "%lf"
+    return PrintDouble(buf, sz, v, 6);
+  }
+
+  // what printf(Format(v, precision, scientific)) prints, into buf
+  inline int PrintNumber(char* buf, std::size_t sz, double v, int precision, bool scientific) {
+    if ( scientific )
+      return std::snprintf(buf, sz, "%.*e", precision, v);
+    return PrintDouble(buf, sz, v, precision);
+  }
+
+  inline int PrintNumber(char* buf, std::size_t sz, long double v, int precision, bool scientific) {
+    return std::snprintf(buf, sz, scientific ? "%.*Le" : "%.*Lf", precision, v);
+  }
+
+} // namespace Formats
+
+#endif // FAST_C_FORMATS_H
@@ -0,0 +1,118 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 11:57:06 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef UTILS_LOSER_TREE_HPP
+#define UTILS_LOSER_TREE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Ext {
+
+  //===========
+  // LoserTree : tournament tree for a k-way merge.  Leaf i holds the current
+  //              head of input i, a pointer, or nullptr once that input is
+  //              spent.  Each internal node keeps the loser of the match
+  //              played there and node 0 the overall winner, so replacing
+  //              the winner's leaf replays one match per level: ceil(log2(k))
+  //              comparisons, no allocation, nothing reshuffled.
+  //             Compare is a strict weak ordering on the pointed-to values.
+  //              Ties go to the lower leaf index, so a merge is stable over
+  //              inputs, and nullptr loses to everything.
+  //             Only the winner may change between build() and the next
+  //              top(); a loser's leaf is read by replays from other leaves.
+  //===========
+  template <typename T, typename Compare>
+  class LoserTree {
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    explicit LoserTree(size_type k, const Compare& c = Compare())
+      : n_(k), leaves_(k, nullptr), nodes_(k ? k : 1, 0), cmp_(c) { /* */ }
+
+    inline size_type size() const { return n_; }
+
+    // leaf i before build()
+    inline void set(size_type i, T t) { leaves_[i] = t; }
+
+    // O(k): plays every match once
+    void build() {
+      if ( n_ == 0 )
+        return;
+      std::vector<size_type> w(2*n_); // winner of each subtree, leaves at [n_, 2n_)
+      for ( size_type i = 0; i < n_; ++i )
+        w[n_+i] = i;
+      for ( size_type p = n_-1; p >= 1; --p ) {
+        const size_type a = w[2*p], b = w[2*p+1];
+        if ( beats(b, a) ) {
+          w[p] = b;
+          nodes_[p] = a;
+        } else {
+          w[p] = a;
+          nodes_[p] = b;
+        }
+      } // for
+      nodes_[0] = (n_ > 1) ? w[1] : 0;
+    }
+
+    inline bool any() const { return top() != nullptr; }
+
+    // the winner's leaf index and value; nullptr once every leaf is
+    inline size_type top_index() const { return nodes_[0]; }
+    inline T top() const { return n_ ? leaves_[nodes_[0]] : nullptr; }
+
+    // new head for the winner's input (nullptr when spent)
+    inline void replace_top(T t) {
+      size_type w = nodes_[0];
+      leaves_[w] = t;
+      for ( size_type p = (w + n_) / 2; p >= 1; p /= 2 ) {
+        if ( beats(nodes_[p], w) )
+          std::swap(nodes_[p], w);
+      } // for
+      nodes_[0] = w;
+    }
+
+  private:
+    // does leaf a win its match against leaf b?
+    inline bool beats(size_type a, size_type b) const {
+      T x = leaves_[a], y = leaves_[b];
+      if ( !y )
+        return x || a < b;
+      if ( !x )
+        return false;
+      if ( cmp_(x, y) )
+        return true;
+      return !cmp_(y, x) && a < b;
+    }
+
+    size_type n_;
+    std::vector<T> leaves_;
+    std::vector<size_type> nodes_; // [0] winner, [1, n_) losers
+    Compare cmp_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_LOSER_TREE_HPP
@@ -0,0 +1,105 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 06:20:44 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef UTILS_MAPPED_FILE_HPP
+#define UTILS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace Ext {
+
+  //============
+  // MappedFile : read-only mmap() of a regular file, from a FILE*'s current
+  //               offset to the end, with a shared read position.  valid() is
+  //               false for pipes, empty files, or when the mapping fails; the
+  //               caller keeps reading through the FILE* in that case.
+  //              Not copyable; the mapping goes away with the object.
+  //============
+  class MappedFile {
+  public:
+    explicit MappedFile(FILE* fp) : base_(nullptr), size_(0), begin_(nullptr), end_(nullptr), cur_(nullptr) {
+      struct stat st;
+      const int fd = fileno(fp);
+      if ( fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 )
+        return;
+      const long offset = std::ftell(fp);
+      if ( offset < 0 || offset >= st.st_size )
+        return;
+      void* m = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( m == MAP_FAILED )
+        return;
+      madvise(m, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+      base_ = m;
+      size_ = static_cast<std::size_t>(st.st_size);
+      begin_ = cur_ = static_cast<char const*>(m) + offset;
+      end_ = static_cast<char const*>(m) + size_;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline bool valid() const { return base_ != nullptr; }
+    inline char const* begin() const { return begin_; }
+    inline char const* end() const { return end_; }
+    inline char const* pos() const { return cur_; }
+    inline void pos(char const* p) { cur_ = p; }
+
+    // next line, including its '\n', or nullptr if no complete line remains
+    inline char const* getline() {
+      char const* nl = static_cast<char const*>(std::memchr(cur_, '\n', static_cast<std::size_t>(end_ - cur_)));
+      if ( !nl )
+        return nullptr;
+      char const* line = cur_;
+      cur_ = nl + 1;
+      return line;
+    }
+
+    // start of the line holding p
+    inline char const* line_start(char const* p) const {
+      while ( p != begin_ && *(p-1) != '\n' )
+        --p;
+      return p;
+    }
+
+    ~MappedFile() {
+      if ( base_ )
+        munmap(base_, size_);
+    }
+
+  private:
+    void* base_;
+    std::size_t size_;
+    char const* begin_;
+    char const* end_;
+    char const* cur_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_MAPPED_FILE_HPP
@@ -24,6 +24,8 @@
 #ifndef ORDERING_COMPARISONS_H
 #define ORDERING_COMPARISONS_H
 
+#include <cmath>
+
 namespace Ordering {
 
   // function objects for comparing values, then addresses
@@ -45,6 +47,24 @@ namespace Ordering {
       }
   };
 
+  // as CompValueThenAddressLesser<>, for elements that convert to a number V, but
+  //  addresses only break ties between values that print the same: -0 goes before
+  //  0 and NaNs, which compare unequal to everything, go after all numbers
+  template <typename T1, typename V, typename T2=T1>
+  struct CompNumberThenAddressLesser {
+      inline bool operator()(T1 const* t1, T2 const* t2) const {
+        const V v1 = static_cast<V>(*t1), v2 = static_cast<V>(*t2);
+        const bool n1 = std::isnan(v1), n2 = std::isnan(v2);
+        if ( n1 != n2 )
+          return(n2);
+        if ( !n1 && v1 != v2 )
+          return(v1 < v2);
+        if ( std::signbit(v1) != std::signbit(v2) ) // -0 and 0, or -nan and nan
+          return(std::signbit(v1));
+        return(t1 < t2);
+      }
+  };
+
 } // namespace Ordering
 
 #endif // ORDERING_COMPARISONS_H
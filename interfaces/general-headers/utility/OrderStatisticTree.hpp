@@ -0,0 +1,237 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 04:38:21 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef UTILS_ORDER_STATISTIC_TREE_HPP
+#define UTILS_ORDER_STATISTIC_TREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Ext {
+
+  //====================
+  // OrderStatisticTree : sorted set of unique keys with O(log n) insert(),
+  //                       erase(), select() (k-th smallest) and rank().
+  //                      A treap whose nodes live in one vector and are
+  //                       recycled through a free list, so a sliding window
+  //                       stops allocating once it reaches its widest point.
+  //====================
+  template <typename T, typename Comp = std::less<T>>
+  class OrderStatisticTree {
+  public:
+    typedef T value_type;
+
+    explicit OrderStatisticTree(const Comp& c = Comp())
+      : comp_(c), root_(NIL), free_(NIL), seed_(0x9E3779B9u) {
+      nodes_.push_back(Node()); // NIL sentinel: size 0
+    }
+
+    inline std::size_t size() const { return nodes_[root_].size_; }
+    inline bool empty() const { return root_ == NIL; }
+
+    void clear() {
+      nodes_.resize(1);
+      root_ = free_ = NIL;
+    }
+
+    inline void insert(const T& t) {
+      root_ = insert(root_, make(t));
+    }
+
+    inline bool erase(const T& t) {
+      bool found = false;
+      root_ = erase(root_, t, found);
+      return found;
+    }
+
+    // k-th smallest, zero-based; requires k < size()
+    const T& select(std::size_t k) const {
+      Idx i = root_;
+      while ( true ) {
+        const std::size_t ls = nodes_[nodes_[i].left_].size_;
+        if ( k < ls )
+          i = nodes_[i].left_;
+        else if ( k == ls )
+          return nodes_[i].key_;
+        else {
+          k -= ls + 1;
+          i = nodes_[i].right_;
+        }
+      } // while
+    }
+
+    // number of keys for which pred(key) is true; pred must hold for some
+    //  prefix of the sorted keys and for nothing after, like comp(key, t)
+    template <typename Pred>
+    std::size_t count_prefix(Pred pred) const {
+      std::size_t n = 0;
+      Idx i = root_;
+      while ( i != NIL ) {
+        if ( pred(nodes_[i].key_) ) {
+          n += nodes_[nodes_[i].left_].size_ + 1;
+          i = nodes_[i].right_;
+        } else {
+          i = nodes_[i].left_;
+        }
+      } // while
+      return n;
+    }
+
+    // number of keys less than t
+    inline std::size_t rank(const T& t) const {
+      return count_prefix([this, &t](const T& k) { return comp_(k, t); });
+    }
+
+  private:
+    typedef std::uint32_t Idx;
+    static constexpr Idx NIL = 0;
+
+    struct Node {
+      Node() : size_(0), prio_(0), left_(NIL), right_(NIL) { /* */ }
+      T key_;
+      std::size_t size_;
+      std::uint32_t prio_;
+      Idx left_, right_;
+    };
+
+    inline void pull(Idx i) {
+      Node& nd = nodes_[i];
+      nd.size_ = nodes_[nd.left_].size_ + nodes_[nd.right_].size_ + 1;
+    }
+
+    Idx make(const T& t) {
+      Idx i = free_;
+      if ( i != NIL ) {
+        free_ = nodes_[i].right_;
+      } else {
+        i = static_cast<Idx>(nodes_.size());
+        nodes_.push_back(Node());
+      }
+      seed_ ^= seed_ << 13; seed_ ^= seed_ >> 17; seed_ ^= seed_ << 5; // xorshift32
+      Node& nd = nodes_[i];
+      nd.key_ = t;
+      nd.prio_ = seed_;
+      nd.left_ = nd.right_ = NIL;
+      pull(i);
+      return i;
+    }
+
+    inline void release(Idx i) {
+      nodes_[i].right_ = free_;
+      free_ = i;
+    }
+
+    // descend to where n's priority belongs, then split what is there around it
+    Idx insert(Idx i, Idx n) {
+      if ( i == NIL )
+        return n;
+      if ( nodes_[n].prio_ > nodes_[i].prio_ ) {
+        Idx l, r;
+        split(i, nodes_[n].key_, false, l, r);
+        nodes_[n].left_ = l;
+        nodes_[n].right_ = r;
+        pull(n);
+        return n;
+      }
+      if ( comp_(nodes_[n].key_, nodes_[i].key_) ) {
+        const Idx c = insert(nodes_[i].left_, n);
+        nodes_[i].left_ = c;
+      } else {
+        const Idx c = insert(nodes_[i].right_, n);
+        nodes_[i].right_ = c;
+      }
+      pull(i);
+      return i;
+    }
+
+    // descend to t and merge its children in its place
+    Idx erase(Idx i, const T& t, bool& found) {
+      if ( i == NIL )
+        return NIL;
+      if ( comp_(t, nodes_[i].key_) ) {
+        const Idx c = erase(nodes_[i].left_, t, found);
+        nodes_[i].left_ = c;
+      } else if ( comp_(nodes_[i].key_, t) ) {
+        const Idx c = erase(nodes_[i].right_, t, found);
+        nodes_[i].right_ = c;
+      } else {
+        found = true;
+        const Idx m = merge(nodes_[i].left_, nodes_[i].right_);
+        release(i);
+        return m;
+      }
+      if ( found )
+        pull(i);
+      return i;
+    }
+
+    // l gets keys < t (orEqual: keys <= t), r gets the rest
+    void split(Idx i, const T& t, bool orEqual, Idx& l, Idx& r) {
+      if ( i == NIL ) {
+        l = r = NIL;
+        return;
+      }
+      const bool goesLeft = orEqual ? !comp_(t, nodes_[i].key_) : comp_(nodes_[i].key_, t);
+      if ( goesLeft ) {
+        Idx rr;
+        split(nodes_[i].right_, t, orEqual, rr, r);
+        nodes_[i].right_ = rr;
+        l = i;
+      } else {
+        Idx ll;
+        split(nodes_[i].left_, t, orEqual, l, ll);
+        nodes_[i].left_ = ll;
+        r = i;
+      }
+      pull(i);
+    }
+
+    Idx merge(Idx l, Idx r) {
+      if ( l == NIL )
+        return r;
+      if ( r == NIL )
+        return l;
+      if ( nodes_[l].prio_ > nodes_[r].prio_ ) {
+        const Idx m = merge(nodes_[l].right_, r);
+        nodes_[l].right_ = m;
+        pull(l);
+        return l;
+      }
+      const Idx m = merge(l, nodes_[r].left_);
+      nodes_[r].left_ = m;
+      pull(r);
+      return r;
+    }
+
+    Comp comp_;
+    std::vector<Node> nodes_;
+    Idx root_;
+    Idx free_;
+    std::uint32_t seed_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_ORDER_STATISTIC_TREE_HPP
@@ -0,0 +1,235 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 03:21:23 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef ORDERED_OUTPUT_REASSEMBLY_HPP
+#define ORDERED_OUTPUT_REASSEMBLY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+#include "utility/Assertion.hpp"
+#include "utility/Exception.hpp"
+#include "utility/FastFormats.hpp"
+
+namespace Ext {
+
+  //===============
+  // OrderedOutput : reassembles output written concurrently, one Buffer per
+  //                  item (e.g.; one per chromosome), so that item i reaches
+  //                  the output stream only after items 0..i-1.  The caller
+  //                  decides the order, typically sort-bed's chromosome order.
+  //                 The Buffer at the head of the line streams straight
+  //                  through.  Others are held in memory; once everything
+  //                  held passes the memory cap, they spill to unlinked
+  //                  temporary files (under $TMPDIR).
+  //                 Each Buffer has a single writer; done(i) may be called
+  //                  from any thread, after which Buffer i must not be used.
+  //===============
+  class OrderedOutput {
+  public:
+    static constexpr std::size_t DefaultMemCap = 256*1024*1024;
+
+    class Buffer {
+    public:
+      inline void put(char c) {
+        mem_.push_back(c);
+        if ( mem_.size() >= check_ )
+          flush();
+      }
+
+      inline void put(char const* s) {
+        mem_.append(s);
+        if ( mem_.size() >= check_ )
+          flush();
+      }
+
+      inline void write(char const* s, std::size_t n) {
+        mem_.append(s, n);
+        if ( mem_.size() >= check_ )
+          flush();
+      }
+
+      template <typename T>
+      inline typename std::enable_if<std::is_integral<T>::value>::type
+      put(T t) {
+        char buf[24];
+        char* p = buf + sizeof(buf);
+        typename std::make_unsigned<T>::type u = t;
+        const bool neg = (t < 0);
+        if ( neg )
+          u = 0 - u;
+        do {
+          *--p = static_cast<char>('0' + (u % 10));
+          u /= 10;
+        } while ( u );
+        if ( neg )
+          *--p = '-';
+        write(p, static_cast<std::size_t>(buf + sizeof(buf) - p));
+      }
+
+      template <typename T>
+      inline typename std::enable_if<std::is_floating_point<T>::value>::type
+      put(T t) { // as printf(Formats::Format(t), t)
+        char buf[512];
+        const int n = Formats::PrintNumber(buf, sizeof(buf), t);
+        if ( n >= 0 && n < static_cast<int>(sizeof(buf)) ) {
+          write(buf, static_cast<std::size_t>(n));
+        } else if ( n > 0 ) {
+          std::string s(static_cast<std::size_t>(n) + 1, '\0');
+          Formats::PrintNumber(&s[0], s.size(), t);
+          write(s.data(), static_cast<std::size_t>(n));
+        }
+      }
+
+      ~Buffer() {
+        if ( spill_ )
+          std::fclose(spill_);
+        owner_.inmem_ -= counted_;
+      }
+
+    private:
+      friend class OrderedOutput;
+      static constexpr std::size_t CheckSz = 1 << 16;
+
+      explicit Buffer(OrderedOutput& owner)
+        : owner_(owner), spill_(nullptr), check_(CheckSz), counted_(0), live_(false), done_(false)
+        { mem_.reserve(CheckSz); }
+
+      Buffer(const Buffer&) = delete;
+      Buffer& operator=(const Buffer&) = delete;
+
+      void flush() {
+        if ( live_.load(std::memory_order_acquire) ) {
+          drain();
+        } else {
+          owner_.inmem_ += (mem_.size() - counted_);
+          counted_ = mem_.size();
+          if ( owner_.inmem_ > owner_.memcap_ )
+            spill();
+        }
+        check_ = mem_.size() + CheckSz;
+      }
+
+      void spill() {
+        if ( mem_.empty() )
+          return;
+        if ( !spill_ )
+          spill_ = owner_.tmpfile();
+        Assert<FileError>(std::fwrite(mem_.data(), 1, mem_.size(), spill_) == mem_.size(),
+                          "Unable to write to temporary file");
+        owner_.inmem_ -= counted_;
+        counted_ = 0;
+        mem_.clear();
+      }
+
+      void drain() { // everything held so far goes to the output stream
+        if ( spill_ ) {
+          char buf[1 << 16];
+          std::size_t n = 0;
+          std::rewind(spill_);
+          while ( (n = std::fread(buf, 1, sizeof(buf), spill_)) > 0 )
+            std::fwrite(buf, 1, n, owner_.out_);
+          std::fclose(spill_);
+          spill_ = nullptr;
+        }
+        std::fwrite(mem_.data(), 1, mem_.size(), owner_.out_);
+        owner_.inmem_ -= counted_;
+        counted_ = 0;
+        mem_.clear();
+      }
+
+      OrderedOutput& owner_;
+      std::string mem_;
+      FILE* spill_;
+      std::size_t check_;
+      std::size_t counted_;
+      std::atomic<bool> live_;
+      bool done_;
+    };
+
+    explicit OrderedOutput(std::size_t nitems, FILE* out = stdout, std::size_t memcap = DefaultMemCap)
+      : out_(out), memcap_(memcap), inmem_(0), head_(0) {
+      bufs_.reserve(nitems);
+      for ( std::size_t i = 0; i < nitems; ++i )
+        bufs_.emplace_back(new Buffer(*this));
+      if ( nitems )
+        bufs_[0]->live_ = true;
+    }
+
+    inline Buffer& operator[](std::size_t i) { return *bufs_[i]; }
+    inline std::size_t size() const { return bufs_.size(); }
+
+    void done(std::size_t i) {
+      Buffer& b = *bufs_[i];
+      if ( !b.live_.load(std::memory_order_acquire) )
+        b.flush(); // account for, and maybe spill, what is held
+      std::lock_guard<std::mutex> lock(mtx_);
+      b.done_ = true;
+      while ( head_ < bufs_.size() && bufs_[head_]->done_ ) {
+        bufs_[head_]->drain();
+        bufs_[head_].reset();
+        ++head_;
+      } // while
+      if ( head_ < bufs_.size() )
+        bufs_[head_]->live_.store(true, std::memory_order_release);
+    }
+
+  private:
+    OrderedOutput(const OrderedOutput&) = delete;
+    OrderedOutput& operator=(const OrderedOutput&) = delete;
+
+    FILE* tmpfile() {
+      const char* tmpdir = std::getenv("TMPDIR");
+      std::string name = std::string((tmpdir && *tmpdir) ? tmpdir : "/tmp") + "/bedops.XXXXXX";
+      std::vector<char> tmpl(name.begin(), name.end());
+      tmpl.push_back('\0');
+      const int fd = mkstemp(&tmpl[0]);
+      Assert<FileError>(fd != -1, "Unable to create temporary file: " + name);
+      unlink(&tmpl[0]);
+      FILE* f = fdopen(fd, "w+");
+      if ( !f )
+        close(fd);
+      Assert<FileError>(f != nullptr, "Unable to open temporary file: " + name);
+      return f;
+    }
+
+    FILE* out_;
+    const std::size_t memcap_;
+    std::atomic<std::size_t> inmem_;
+    std::size_t head_;
+    std::mutex mtx_;
+    std::vector<std::unique_ptr<Buffer>> bufs_; // last: Buffers need the members above
+  };
+
+} // namespace Ext
+
+#endif // ORDERED_OUTPUT_REASSEMBLY_HPP
@@ -0,0 +1,170 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 08:55:34 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef OUTPUT_BLOCK_BUFFER_HPP
+#define OUTPUT_BLOCK_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "utility/FastFormats.hpp"
+
+namespace Ext {
+
+  //==============
+  // OutputBuffer : collects output in one large block and hands it to the
+  //                 FILE* a block at a time.  Has the same put()/write()
+  //                 interface as OrderedOutput::Buffer, so Bed::println(w)
+  //                 and friends write into either.  Integers are converted
+  //                 by hand and floating point goes through
+  //                 Formats::PrintNumber(); both give exactly what printf()
+  //                 gives with the matching Formats::Format().
+  //               Whatever else writes to the same FILE* must flush() first.
+  //               StdOut() is the calling thread's buffer on stdout, flushed
+  //                 when the thread ends (for the main thread, in exit()).
+  //                 PrintTypes and the Bed types write into it; anything
+  //                 that skips exit(), like a forked child's _exit(), must
+  //                 flush() it by hand.
+  //==============
+  class OutputBuffer {
+  public:
+    static constexpr std::size_t BlockSz = 1 << 20;
+
+    explicit OutputBuffer(FILE* out = stdout, std::size_t blocksz = BlockSz)
+      : out_(out), buf_(new char[blocksz]), cur_(buf_), end_(buf_ + blocksz)
+      { /* */ }
+
+    inline void put(char c) {
+      if ( cur_ == end_ )
+        flush();
+      *cur_++ = c;
+    }
+
+    inline void put(char const* s) {
+      write(s, std::strlen(s));
+    }
+
+    inline void write(char const* s, std::size_t n) {
+      if ( static_cast<std::size_t>(end_ - cur_) < n ) {
+        flush();
+        if ( static_cast<std::size_t>(end_ - cur_) < n ) { // bigger than a block
+          std::fwrite(s, 1, n, out_);
+          return;
+        }
+      }
+      std::memcpy(cur_, s, n);
+      cur_ += n;
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value>::type
+    put(T t) {
+      if ( end_ - cur_ < MaxNumSz )
+        flush();
+      char buf[24];
+      char* p = buf + sizeof(buf);
+      typename std::make_unsigned<T>::type u = t;
+      const bool neg = (t < 0);
+      if ( neg )
+        u = 0 - u;
+      do {
+        *--p = static_cast<char>('0' + (u % 10));
+        u /= 10;
+      } while ( u );
+      if ( neg )
+        *--p = '-';
+      const std::size_t n = static_cast<std::size_t>(buf + sizeof(buf) - p);
+      std::memcpy(cur_, p, n);
+      cur_ += n;
+    }
+
+    // printf(Formats::Format(t), t)
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value>::type
+    put(T t) {
+      if ( end_ - cur_ < MaxNumSz )
+        flush();
+      const int n = Formats::PrintNumber(cur_, MaxNumSz, t);
+      if ( n >= 0 && n < MaxNumSz )
+        cur_ += n;
+      else
+        big(n, t);
+    }
+
+    // printf(Formats::Format(t, precision, scientific), t)
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value>::type
+    put(T t, int precision, bool scientific) {
+      if ( end_ - cur_ < MaxNumSz )
+        flush();
+      const int n = Formats::PrintNumber(cur_, MaxNumSz, t, precision, scientific);
+      if ( n >= 0 && n < MaxNumSz )
+        cur_ += n;
+      else
+        big(n, t, precision, scientific);
+    }
+
+    inline void flush() {
+      if ( cur_ != buf_ ) {
+        std::fwrite(buf_, 1, static_cast<std::size_t>(cur_ - buf_), out_);
+        cur_ = buf_;
+      }
+    }
+
+    ~OutputBuffer() {
+      flush();
+      delete [] buf_;
+    }
+
+  private:
+    static constexpr int MaxNumSz = 512; // all of "%lf" for any double
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    template <typename T, typename... Args>
+    void big(int n, T t, Args... args) { // huge long doubles, or huge precisions
+      if ( n < 0 )
+        return;
+      std::string s(static_cast<std::size_t>(n) + 1, '\0');
+      Formats::PrintNumber(&s[0], s.size(), t, args...);
+      write(s.data(), static_cast<std::size_t>(n));
+    }
+
+    FILE* out_;
+    char* buf_;
+    char* cur_;
+    char* const end_;
+  };
+
+  inline OutputBuffer& StdOut() {
+    static thread_local OutputBuffer out(stdout);
+    return out;
+  }
+
+} // namespace Ext
+
+#endif // OUTPUT_BLOCK_BUFFER_HPP
@@ -24,18 +24,33 @@
 #ifndef UTILS_SIMPLE_SMALLOBJ_MEM
 #define UTILS_SIMPLE_SMALLOBJ_MEM
 
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <limits>
-#include <map>
-#include <set>
-#include <utility>
+#include <new>
+#include <type_traits>
 
 #include "utility/BitMonitor.hpp"
 
 namespace Ext {
 
+  namespace Details {
+    constexpr std::size_t CeilPow2(std::size_t n, std::size_t p = 1) {
+      return (p >= n) ? p : CeilPow2(n, 2*p);
+    }
+  } // namespace Details
+
   //==============
-  // PooledMemory
+  // PooledMemory : slots are raw storage; construct() builds an object in one and
+  //                 release() destroys it.  CallDestruct is no longer needed for
+  //                 that and is kept so existing instantiations still compile.
+  //                Each chunk sits on a boundary of its own size rounded up to a
+  //                 power of 2, so release() finds the owner of a slot by masking
+  //                 its address.  Live chunks are kept on a doubly linked list.
+  //               pool_of() and reclaim() let a wrapper such as
+  //                 ConcurrentPooledMemory route a slot back to the pool that
+  //                 built it after the object was destroyed elsewhere.
   //==============
   template <typename DataType, std::size_t chunksz = 512, bool CallDestruct = false>
   struct PooledMemory; // atm, chunksz needs to be a power of 8 and at least 64
@@ -44,12 +59,11 @@ namespace Ext {
   struct PooledMemory {
     typedef DataType type;
 
-    PooledMemory() : _curr(new MemChunk()), _cache(nullptr)
-     {
-       _blocks.insert(_curr);
-       _blockstarts.insert(_curr->_data);
-       _r.insert(std::make_pair(_curr->_data, _curr));
-     }
+    PooledMemory() : _curr(new_chunk()), _cache(nullptr), _head(nullptr)
+      { link(_curr); }
+
+    PooledMemory(const PooledMemory&) = delete;
+    PooledMemory& operator=(const PooledMemory&) = delete;
 
     template <typename... Args>
     inline
@@ -58,93 +72,90 @@ namespace Ext {
         if ( _cache )
           _curr = _cache;
         else
-          _curr = new MemChunk();
+          _curr = new_chunk();
 
         _cache = nullptr;
-        _blocks.insert(_curr);
-        _blockstarts.insert(_curr->_data);
-        _r.insert(std::make_pair(_curr->_data, _curr));
+        link(_curr);
       }
       return _curr->add(parameters...);
     }
 
     inline
     void release(type* b) {
-      if ( 1 == _blockstarts.size() ) {
-        _curr->remove(b);
-      } else { // possible Chunk removal
-        auto iter = _blockstarts.begin();
-        MemChunk* m;
-        if ( _blockstarts.size() < 10 ) {
-          auto miter = _r.begin();
-          while ( *iter > b ) { ++iter; ++miter; }
-          m = miter->second;
-        } else {
-          iter = _blockstarts.lower_bound(b);
-          m = _r[*iter];
-        }
-        m->remove(b);
-        if ( m->empty() ) {
-          _blocks.erase(m);
-          _blockstarts.erase(iter);
-          _r.erase(*iter);
-          if ( !_cache )
-            _cache = m;
-          else
-            delete m;
-          if ( m == _curr )
-            _curr = *(_blocks.begin()); // important if we drop back to 1 block
-        }
+      b->~type();
+      reclaim(b);
+    }
+
+    // give back a slot whose object has already been destroyed
+    inline
+    void reclaim(type* b) {
+      MemChunk* m = owner(b);
+      m->remove(b);
+      if ( m->empty() && _head->_next ) { // never give up the last chunk
+        unlink(m);
+        if ( !_cache )
+          _cache = m;
+        else
+          delete_chunk(m);
+        if ( m == _curr )
+          _curr = _head;
       }
     }
 
+    // the pool whose construct() returned b
+    static inline PooledMemory* pool_of(type* b) {
+      return owner(b)->_pool;
+    }
+
     ~PooledMemory() {
-      for ( auto b : _blocks )
-        delete b;
+      while ( _head ) {
+        MemChunk* m = _head;
+        unlink(m);
+        delete_chunk(m);
+      } // while
       if ( _cache )
-        delete _cache;
+        delete_chunk(_cache);
     }
 
   private:
     template <std::size_t basesz, std::size_t nelements>
     struct Chunk {
-      Chunk() : _any(true), _cntr(0), _data{} { }
+      Chunk() : _any(true), _cntr(0), _prev(nullptr), _next(nullptr), _pool(nullptr) { }
 
       inline bool any() const { return _any; } // any positions available?
       inline bool empty() const { return _cntr == 0; } // nothing set
+      inline type* slots() { return reinterpret_cast<type*>(_data); }
 
       template <typename... Args>
       inline type* add(Args... parameters) {
         std::size_t trackpos = _tracker.get_open();
-        type* address = static_cast<type*>(_data+trackpos);
-        if ( CallDestruct && address ) { address->~type(); }
+        type* address = new(slots()+trackpos) type(parameters...);
         _any &= _tracker.set(trackpos);
         ++_cntr;
-        return new(address) type(parameters...);
+        return address;
       }
 
       inline void remove(type* bt) {
-        // lazy deletion (see add())
-        _tracker.unset(bt-_data);
+        _tracker.unset(bt-slots());
         _any = true;
         --_cntr;
       }
 
-      /* temporary disable -> double destruction is happening at times
-           for now, use with types that have trivial destructors
       ~Chunk() {
-        if ( CallDestruct ) {
-          for ( std::size_t i = 0; i < _tracker.size(); ++i ) {
-            type* address = static_cast<type*>(_data+i);
-            if ( address ) { address->~type(); }
+        if ( !std::is_trivially_destructible<type>::value ) {
+          for ( std::size_t i = _tracker.next_set(0, nelements, true); _cntr > 0 && i < nelements; i = _tracker.next_set(i) ) {
+            slots()[i].~type();
+            --_cntr;
           } // for
         }
       }
-      */
 
       bool _any;
       std::size_t _cntr;
-      type _data[nelements];
+      Chunk* _prev;
+      Chunk* _next;
+      PooledMemory* _pool;
+      typename std::aligned_storage<sizeof(type), alignof(type)>::type _data[nelements];
       //BitMonitor<basesz, nelements> _tracker; // nelements == nbits monitored
       BitMonitor2<basesz, nelements> _tracker; // nelements == nbits monitored
     };
@@ -154,12 +165,45 @@ namespace Ext {
     static constexpr std::size_t NBits = Pow<BaseSize, IntLogN<BaseSize, chunksz>::value>::value;
     typedef Chunk<BaseSize, NBits> MemChunk;
 
+    static constexpr std::size_t ChunkAlign = Details::CeilPow2(sizeof(MemChunk));
+
+    static MemChunk* new_chunk() {
+      void* p = nullptr;
+      if ( posix_memalign(&p, ChunkAlign, sizeof(MemChunk)) != 0 )
+        throw std::bad_alloc();
+      return new(p) MemChunk();
+    }
+
+    static void delete_chunk(MemChunk* m) {
+      m->~MemChunk();
+      std::free(m);
+    }
+
+    static inline MemChunk* owner(type* b) {
+      return reinterpret_cast<MemChunk*>(reinterpret_cast<std::uintptr_t>(b) & ~std::uintptr_t(ChunkAlign - 1));
+    }
+
+    inline void link(MemChunk* m) {
+      m->_pool = this;
+      m->_prev = nullptr;
+      m->_next = _head;
+      if ( _head )
+        _head->_prev = m;
+      _head = m;
+    }
+
+    inline void unlink(MemChunk* m) {
+      if ( m->_prev )
+        m->_prev->_next = m->_next;
+      else
+        _head = m->_next;
+      if ( m->_next )
+        m->_next->_prev = m->_prev;
+    }
+
     MemChunk* _curr;
     MemChunk* _cache;
-    // Important to remember that _blocks, _blockstarts, _r all have the same #elements
-    std::set<MemChunk*, std::greater<MemChunk*>> _blocks;
-    std::set<type*, std::greater<type*>> _blockstarts;
-    std::map<type*, MemChunk*, std::greater<type*>> _r;
+    MemChunk* _head; // live chunks, _curr among them
   };
 
 } // namespace Ext
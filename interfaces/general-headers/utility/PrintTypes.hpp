@@ -29,6 +29,7 @@
 #include <type_traits>
 
 #include "utility/Formats.hpp"
+#include "utility/OutputBuffer.hpp"
 
 namespace PrintTypes {
 
@@ -45,33 +46,29 @@ namespace PrintTypes {
   template <typename T>
   typename std::enable_if<Details::check<T>::value>::type
   Print(T t) {
-    static std::string f = Formats::Format(t);
-    static char const* format = f.c_str();
-    std::printf(format, t);
+    Ext::StdOut().put(t);
   }
 
   template <typename T>
   typename std::enable_if<Details::check<T>::value>::type
   Println(T t) {
-    static std::string end = Formats::Format(t) + std::string("\n");
-    static char const* format = end.c_str();
-    std::printf(format, t);
+    Ext::OutputBuffer& out = Ext::StdOut();
+    out.put(t);
+    out.put('\n');
   }
 
   template <typename T>
   typename std::enable_if<std::is_arithmetic<T>::value>::type
   Print(T t, int precision, bool scientific) {
-    std::string f = Formats::Format(t, precision, scientific);
-    char const* format = f.c_str();
-    std::printf(format, t);
+    Ext::StdOut().put(t, precision, scientific);
   }
 
   template <typename T>
   typename std::enable_if<std::is_arithmetic<T>::value>::type
   Println(T t, int precision, bool scientific) {
-    std::string end = Formats::Format(t, precision, scientific) + std::string("\n");
-    char const* format = end.c_str();
-    std::printf(format, t);
+    Ext::OutputBuffer& out = Ext::StdOut();
+    out.put(t, precision, scientific);
+    out.put('\n');
   }
 
   template <typename T>
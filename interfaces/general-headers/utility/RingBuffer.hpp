@@ -0,0 +1,114 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 03:31:01 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#ifndef UTILS_RING_BUFFER_HPP
+#define UTILS_RING_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+namespace Ext {
+
+  //============
+  // RingBuffer : contiguous, growable FIFO with deque-like push_back(),
+  //               pop_front(), pop_back() and operator[].  Capacity is a power of 2 and
+  //               doubles when full; it never shrinks, so once a window has
+  //               seen its widest point there is no more allocation at all.
+  //              Holds trivially copyable things only (pointers, in sweep()).
+  //============
+  template <typename T>
+  class RingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "RingBuffer<T> requires trivially copyable T");
+
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    explicit RingBuffer(size_type initCapacity = 64)
+      : buf_(nullptr), mask_(0), head_(0), sz_(0) {
+      size_type cap = 1;
+      while ( cap < initCapacity )
+        cap <<= 1;
+      buf_ = static_cast<T*>(std::malloc(cap * sizeof(T)));
+      if ( !buf_ )
+        throw std::bad_alloc();
+      mask_ = cap - 1;
+    }
+
+    ~RingBuffer() { std::free(buf_); }
+
+    inline bool empty() const { return sz_ == 0; }
+    inline size_type size() const { return sz_; }
+    inline size_type capacity() const { return mask_ + 1; }
+
+    inline T& operator[](size_type i) { return buf_[(head_ + i) & mask_]; }
+    inline const T& operator[](size_type i) const { return buf_[(head_ + i) & mask_]; }
+    inline T& front() { return buf_[head_]; }
+    inline T& back() { return buf_[(head_ + sz_ - 1) & mask_]; }
+
+    inline void push_back(const T& t) {
+      if ( sz_ > mask_ )
+        grow();
+      buf_[(head_ + sz_) & mask_] = t;
+      ++sz_;
+    }
+
+    inline void pop_front() {
+      head_ = (head_ + 1) & mask_;
+      --sz_;
+    }
+
+    inline void pop_back() {
+      --sz_;
+    }
+
+    inline void clear() { head_ = 0; sz_ = 0; }
+
+  private:
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    void grow() { // full: unwrap into twice the space
+      const size_type cap = mask_ + 1;
+      T* nbuf = static_cast<T*>(std::malloc(2 * cap * sizeof(T)));
+      if ( !nbuf )
+        throw std::bad_alloc();
+      for ( size_type i = 0; i < sz_; ++i )
+        nbuf[i] = buf_[(head_ + i) & mask_];
+      std::free(buf_);
+      buf_ = nbuf;
+      head_ = 0;
+      mask_ = 2 * cap - 1;
+    }
+
+    T* buf_;
+    size_type mask_;
+    size_type head_;
+    size_type sz_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_RING_BUFFER_HPP
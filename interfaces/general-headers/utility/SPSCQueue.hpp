@@ -0,0 +1,137 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 11:24:36 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+
+#ifndef UTILS_SPSC_QUEUE_HPP
+#define UTILS_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace Ext {
+
+  //===========
+  // SPSCQueue : bounded, lock-free FIFO between exactly one producer thread
+  //              (push) and one consumer thread (pop).  Capacity is a power
+  //              of 2.  Each side keeps its own copy of the other's index and
+  //              reads the shared one only when that copy says full or empty.
+  //             Holds trivially copyable things only (record pointers).
+  //===========
+  template <typename T>
+  class SPSCQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SPSCQueue<T> requires trivially copyable T");
+
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    explicit SPSCQueue(size_type capacity = 4096)
+      : buf_(nullptr), mask_(0), head_(0), tailSeen_(0), tail_(0), headSeen_(0) {
+      size_type cap = 2;
+      while ( cap < capacity )
+        cap <<= 1;
+      buf_ = static_cast<T*>(std::malloc(cap * sizeof(T)));
+      if ( !buf_ )
+        throw std::bad_alloc();
+      mask_ = cap - 1;
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    ~SPSCQueue() { std::free(buf_); }
+
+    inline size_type capacity() const { return mask_ + 1; }
+
+    // producer only; false when full
+    inline bool push(const T& t) {
+      const size_type tl = tail_.load(std::memory_order_relaxed);
+      if ( tl - headSeen_ > mask_ ) {
+        headSeen_ = head_.load(std::memory_order_acquire);
+        if ( tl - headSeen_ > mask_ )
+          return false;
+      }
+      buf_[tl & mask_] = t;
+      tail_.store(tl + 1, std::memory_order_release);
+      return true;
+    }
+
+    // consumer only; false when empty
+    inline bool pop(T& t) {
+      const size_type hd = head_.load(std::memory_order_relaxed);
+      if ( hd == tailSeen_ ) {
+        tailSeen_ = tail_.load(std::memory_order_acquire);
+        if ( hd == tailSeen_ )
+          return false;
+      }
+      t = buf_[hd & mask_];
+      head_.store(hd + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    static constexpr std::size_t LineSz = 64;
+
+    T* buf_;
+    size_type mask_;
+    char pad0_[LineSz];
+    std::atomic<size_type> head_; // consumer's side
+    size_type tailSeen_;
+    char pad1_[LineSz];
+    std::atomic<size_type> tail_; // producer's side
+    size_type headSeen_;
+    char pad2_[LineSz];
+  };
+
+  //=========
+  // Backoff : how a side of an SPSCQueue waits on the other.  Spin first, then
+  //            yield, then sleep in short naps so that a reader stalled on
+  //            slow storage costs the waiting thread next to no CPU.
+  //=========
+  struct Backoff {
+    Backoff() : n_(0) { }
+
+    inline void wait() {
+      if ( n_ < 64 )
+        ++n_;
+      else if ( n_ < 128 ) {
+        ++n_;
+        std::this_thread::yield();
+      } else
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    inline void reset() { n_ = 0; }
+
+  private:
+    unsigned n_;
+  };
+
+} // namespace Ext
+
+#endif // UTILS_SPSC_QUEUE_HPP
@@ -23,12 +23,14 @@
 
 #include <cstdlib>
 #include <deque>
+#include <vector>
 
 #include "data/bed/AllocateIterator_BED_starch_minmem.hpp"
 #include "data/bed/AllocateIterator_BED_starch.hpp"
 #include "data/bed/BedCheckIterator.hpp"
 #include "data/bed/BedCheckIterator_minmem.hpp"
 #include "utility/AllocateIterator.hpp"
+#include "utility/RingBuffer.hpp"
 
 namespace WindowSweep {
 
@@ -36,6 +38,17 @@ namespace WindowSweep {
 
   namespace Details {
 
+    // The sliding window of a sweep.  Dense inputs push and pop it millions
+    //  of times per chromosome; a ring buffer does that without allocating.
+    //  Build with -DSWEEP_DEQUE_WINDOW for the older std::deque window.
+#ifdef SWEEP_DEQUE_WINDOW
+    template <typename T>
+    using Window = std::deque<T>;
+#else
+    template <typename T>
+    using Window = Ext::RingBuffer<T>;
+#endif
+
     // get() & clean() function overloads allow sweep() to be written only twice.
     //  New iterator ideas receive just another get().  For example,
     //  the speedy allocate_iterator<T> requires something special below.
@@ -71,13 +84,13 @@ namespace WindowSweep {
 
 
     // fastest iterator (v2p4p27 and newer)
-    template <typename T, std::size_t PoolSz> // pooled memory
-    inline typename Bed::allocate_iterator_starch_bed<T*, PoolSz>::value_type
-                                     get(Bed::allocate_iterator_starch_bed<T*, PoolSz>& i)
+    template <typename T, std::size_t PoolSz, typename PoolType> // pooled memory
+    inline typename Bed::allocate_iterator_starch_bed<T*, PoolSz, PoolType>::value_type
+                                     get(Bed::allocate_iterator_starch_bed<T*, PoolSz, PoolType>& i)
       { return(*i); } /* no copy via operator new here */
 
-    template <typename T, std::size_t PoolSz>
-    inline void clean(Bed::allocate_iterator_starch_bed<T*, PoolSz>& i, T* p)
+    template <typename T, std::size_t PoolSz, typename PoolType>
+    inline void clean(Bed::allocate_iterator_starch_bed<T*, PoolSz, PoolType>& i, T* p)
       { static auto& pool = i.get_pool(); pool.release(p); }
 
 
@@ -93,13 +106,13 @@ namespace WindowSweep {
 
 
     // pooled memory error checking iterator(v2p4p27 and newer)
-    template <typename T, std::size_t PoolSz>
-    inline typename Bed::bed_check_iterator<T*, PoolSz>::value_type
-                                     get(Bed::bed_check_iterator<T*, PoolSz>& i)
+    template <typename T, std::size_t PoolSz, typename PoolType>
+    inline typename Bed::bed_check_iterator<T*, PoolSz, PoolType>::value_type
+                                     get(Bed::bed_check_iterator<T*, PoolSz, PoolType>& i)
       { return(*i); } /* no copy via operator new here */
 
-    template <typename T, std::size_t PoolSz>
-    inline void clean(Bed::bed_check_iterator<T*, PoolSz>& i, T* p)
+    template <typename T, std::size_t PoolSz, typename PoolType>
+    inline void clean(Bed::bed_check_iterator<T*, PoolSz, PoolType>& i, T* p)
       { static auto& pool = i.get_pool(); pool.release(p); }
 
   } // namespace Details
@@ -118,15 +131,17 @@ namespace WindowSweep {
     // Local typedefs
     typedef typename EventVisitor::RefType Type;
     typedef Type* TypePtr;
-    typedef std::deque<TypePtr> WindowType;
+    typedef Details::Window<TypePtr> WindowType;
+    typedef std::vector<TypePtr> BatchType;
 
     // Local variables
     // const bool cleanHere = !visitor.ManagesOwnMemory(); no longer useful with multivisitor
     InputIterator orig = start;
     const TypePtr zero = static_cast<TypePtr>(0);
     TypePtr bPtr = zero;
-    std::size_t index = 0;
+    std::size_t index = 0, sz = 0;
     WindowType win;
+    BatchType batch;
     TypePtr cache = zero;
     bool first = true;
     bool reset = true;
@@ -136,11 +151,17 @@ namespace WindowSweep {
 
       if ( !reset ) { // Check items falling out of range 'to the left'
         visitor.OnStart(win[index]);
-        while ( !win.empty() && inRange.Map2Ref(win[0], win[index]) < 0 ) {
-          visitor.OnDelete(win[0]);
-          Details::clean(orig, win[0]);
-          win.pop_front(), --index;
-        } // while
+        for ( sz = 0; sz < index && inRange.Map2Ref(win[sz], win[index]) < 0; ++sz )
+          batch.push_back(win[sz]);
+        if ( sz ) {
+          visitor.OnDeleteBatch(&batch[0], sz);
+          for ( auto b : batch ) {
+            Details::clean(orig, b);
+            win.pop_front();
+          } // for
+          batch.clear();
+          index -= sz;
+        }
       } else { // last item in windowed buffer, reset buffer
         if ( start == end && !cache ) { // stopping condition
           visitor.OnEnd();
@@ -181,14 +202,19 @@ namespace WindowSweep {
               visitor.OnPurge(); // starting a new window; notify visitor
             first = false;
 
-            while ( !win.empty() ) { // deletions on behalf of new ref
-              visitor.OnDelete(win[0]);
-              Details::clean(orig, win[0]);
-              win.pop_front();
-            } // while
+            if ( !win.empty() ) { // deletions on behalf of new ref
+              for ( sz = 0; sz < win.size(); ++sz )
+                batch.push_back(win[sz]);
+              visitor.OnDeleteBatch(&batch[0], sz);
+              for ( auto b : batch ) {
+                Details::clean(orig, b);
+                win.pop_front();
+              } // for
+              batch.clear();
+            }
           }
           win.push_back(bPtr);
-          visitor.OnAdd(bPtr); // must follow 'reset' check
+          batch.push_back(bPtr); // visitor.OnAddBatch() must follow 'reset' check
         }
         else { // read one passed current windowed range
           cache = bPtr;
@@ -196,6 +222,10 @@ namespace WindowSweep {
         }
       } // while
 
+      if ( !batch.empty() ) {
+        visitor.OnAddBatch(&batch[0], batch.size());
+        batch.clear();
+      }
       visitor.OnDone(); // done processing current item
 
       reset = (++index >= win.size());
@@ -224,7 +254,8 @@ namespace WindowSweep {
     typedef typename EventVisitor::RefType RefType;
     typedef typename EventVisitor::MapType MapType;
     typedef MapType* MapTypePtr;
-    typedef std::deque<MapTypePtr> WindowType;
+    typedef Details::Window<MapTypePtr> WindowType;
+    typedef std::vector<MapTypePtr> BatchType;
     typedef RefType* RefTypePtr;
 
     // Local variables
@@ -233,6 +264,8 @@ namespace WindowSweep {
     RefTypePtr rPtr;
     MapTypePtr mPtr = zero, cache = zero;
     WindowType win;
+    BatchType batch;
+    std::size_t sz = 0;
     double value = 0;
     bool willPurge = false;
     InputIterator1 rorig = refStart;
@@ -251,11 +284,16 @@ namespace WindowSweep {
         visitor.OnPurge();
 
       // Pop off items falling out of range 'to the left'
-      while ( !win.empty() && inRange.Map2Ref(win[0], rPtr) < 0 ) {
-        visitor.OnDelete(win[0]);
-        Details::clean(morig, win[0]);
-        win.pop_front();
-      } // while
+      for ( sz = 0; sz < win.size() && inRange.Map2Ref(win[sz], rPtr) < 0; ++sz )
+        batch.push_back(win[sz]);
+      if ( sz ) {
+        visitor.OnDeleteBatch(&batch[0], sz);
+        for ( auto b : batch ) {
+          Details::clean(morig, b);
+          win.pop_front();
+        } // for
+        batch.clear();
+      }
 
       // Check for items to be included in current windowed range
       while ( cache || mapFromStart != mapFromEnd ) {
@@ -270,7 +308,7 @@ namespace WindowSweep {
 
         if ( (value = inRange.Ref2Map(rPtr, mPtr)) == 0 ) { // within range
           win.push_back(mPtr);
-          visitor.OnAdd(mPtr);
+          batch.push_back(mPtr);
         }
         else if ( value < 0 ) { // read one passed current windowed range
           cache = mPtr;
@@ -279,6 +317,10 @@ namespace WindowSweep {
         else
           Details::clean(morig, mPtr);
       } // while
+      if ( !batch.empty() ) {
+        visitor.OnAddBatch(&batch[0], batch.size());
+        batch.clear();
+      }
       visitor.OnDone(); // done processing current ref item
       Details::clean(rorig, rPtr);
     } // while more ref data
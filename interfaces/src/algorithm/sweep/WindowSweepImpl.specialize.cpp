@@ -22,7 +22,7 @@
 //
 
 #include <cstdlib>
-#include <deque>
+#include <vector>
 
 #include "data/bed/BedCheckIterator.hpp"
 #include "data/bed/BedDistances.hpp"
@@ -60,14 +60,16 @@ namespace WindowSweep {
     // Local typedefs
     typedef typename EventVisitor::RefType Type;
     typedef Type* TypePtr;
-    typedef std::deque<TypePtr> WindowType;
+    typedef Details::Window<TypePtr> WindowType;
+    typedef std::vector<TypePtr> BatchType;
 
     // Local variables
     // const bool cleanHere = !visitor.ManagesOwnMemory(); no longer useful with multivisitor
     const TypePtr zero = static_cast<TypePtr>(0);
     TypePtr bPtr = zero;
-    std::size_t index = 0;
+    std::size_t index = 0, sz = 0;
     WindowType win;
+    BatchType batch;
     TypePtr cache = zero;
     bool first = true;
     bool reset = true;
@@ -78,12 +80,18 @@ namespace WindowSweep {
 
       if ( !reset ) { // Check items falling out of range 'to the left'
         visitor.OnStart(win[index]);
-        while ( !win.empty() && inRange.Map2Ref(win[0], win[index]) < 0 ) {
-          if ( win[0]->length() >= inRange.ovrRequired_ )
-            visitor.OnDelete(win[0]);
+        for ( sz = 0; sz < index && inRange.Map2Ref(win[sz], win[index]) < 0; ++sz ) {
+          if ( win[sz]->length() >= inRange.ovrRequired_ )
+            batch.push_back(win[sz]);
+        } // for
+        if ( !batch.empty() ) {
+          visitor.OnDeleteBatch(&batch[0], batch.size());
+          batch.clear();
+        }
+        for ( index -= sz; sz > 0; --sz ) {
           Details::clean(orig, win[0]);
-          win.pop_front(), --index;
-        } // while
+          win.pop_front();
+        } // for
       } else { // last item in windowed buffer, reset buffer
         if ( start == end && !cache ) { // stopping condition
           visitor.OnEnd();
@@ -124,16 +132,22 @@ namespace WindowSweep {
               visitor.OnPurge(); // starting a new window; notify visitor
             first = false;
 
-            while ( !win.empty() ) { // deletions on behalf of new ref
-              if ( win[0]->length() >= inRange.ovrRequired_ )
-                visitor.OnDelete(win[0]);
+            for ( sz = 0; sz < win.size(); ++sz ) { // deletions on behalf of new ref
+              if ( win[sz]->length() >= inRange.ovrRequired_ )
+                batch.push_back(win[sz]);
+            } // for
+            if ( !batch.empty() ) {
+              visitor.OnDeleteBatch(&batch[0], batch.size());
+              batch.clear();
+            }
+            while ( !win.empty() ) {
               Details::clean(orig, win[0]);
               win.pop_front();
             } // while
           }
           win.push_back(bPtr);
           if ( bPtr->length() >= inRange.ovrRequired_ )
-            visitor.OnAdd(bPtr); // must follow 'reset' check
+            batch.push_back(bPtr); // visitor.OnAddBatch() must follow 'reset' check
         }
         else { // read one passed current windowed range
           cache = bPtr;
@@ -141,6 +155,10 @@ namespace WindowSweep {
         }
       } // while
 
+      if ( !batch.empty() ) {
+        visitor.OnAddBatch(&batch[0], batch.size());
+        batch.clear();
+      }
       visitor.OnDone(); // done processing current item
 
       reset = (++index >= win.size());
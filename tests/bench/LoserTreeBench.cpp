@@ -0,0 +1,194 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 11:57:06 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+/*
+  Microbenchmark for Ext::LoserTree against the k-way merges bedops used before:
+      scan  : look at every input's next element for the minimum (doUnionAll)
+      heap  : std::priority_queue of (element, input) pairs (doUnionAllPQ)
+      loser : Ext::LoserTree
+  for k = 2, 16, 256 and 2048 sorted inputs of (start, end) coordinates, with
+    many ties between inputs.  Reports ns and comparisons per element merged.
+  All three must give the same sequence, ties to the lower input, so this
+    doubles as a correctness test: exit status 1 on a mismatch.
+  usage: LoserTreeBench [elements]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "utility/LoserTree.hpp"
+
+namespace {
+
+  struct Element {
+    std::uint64_t start_;
+    std::uint64_t end_;
+    std::uint32_t input_;
+  };
+
+  std::uint64_t ncompares = 0;
+
+  struct Less {
+    inline bool operator()(Element const* a, Element const* b) const {
+      ++ncompares;
+      if ( a->start_ != b->start_ )
+        return a->start_ < b->start_;
+      return a->end_ < b->end_;
+    }
+  };
+
+  typedef std::vector<std::vector<Element>> Inputs;
+
+  Inputs make_inputs(std::size_t k, std::size_t n) {
+    std::mt19937_64 rng(k);
+    std::uniform_int_distribution<std::uint64_t> step(0, 3), len(1, 4);
+    Inputs in(k);
+    for ( std::size_t i = 0; i < k; ++i ) {
+      std::uint64_t at = 0;
+      for ( std::size_t j = 0; j < n / k; ++j ) {
+        at += step(rng);
+        in[i].push_back(Element{at, at + len(rng), static_cast<std::uint32_t>(i)});
+      } // for
+      std::sort(in[i].begin(), in[i].end(),
+                [](const Element& a, const Element& b) { return Less()(&a, &b); });
+    } // for
+    return in;
+  }
+
+  void scan(const Inputs& in, std::vector<Element const*>& out) {
+    std::vector<std::size_t> at(in.size(), 0);
+    Less lt;
+    while ( true ) {
+      Element const* mn = nullptr;
+      std::size_t which = 0;
+      for ( std::size_t i = 0; i < in.size(); ++i ) {
+        if ( at[i] == in[i].size() )
+          continue;
+        Element const* e = &in[i][at[i]];
+        if ( !mn || lt(e, mn) ) {
+          mn = e;
+          which = i;
+        }
+      } // for
+      if ( !mn )
+        break;
+      out.push_back(mn);
+      ++at[which];
+    } // while
+  }
+
+  void heap(const Inputs& in, std::vector<Element const*>& out) {
+    typedef std::pair<Element const*, std::size_t> P;
+    auto gt = [](const P& a, const P& b) {
+      Less lt;
+      if ( lt(a.first, b.first) )
+        return false;
+      if ( lt(b.first, a.first) )
+        return true;
+      return a.second > b.second;
+    };
+    std::priority_queue<P, std::vector<P>, decltype(gt)> pq(gt);
+    std::vector<std::size_t> at(in.size(), 0);
+    for ( std::size_t i = 0; i < in.size(); ++i ) {
+      if ( !in[i].empty() )
+        pq.push(P(&in[i][at[i]++], i));
+    } // for
+    while ( !pq.empty() ) {
+      P p = pq.top();
+      pq.pop();
+      out.push_back(p.first);
+      if ( at[p.second] < in[p.second].size() )
+        pq.push(P(&in[p.second][at[p.second]++], p.second));
+    } // while
+  }
+
+  void loser(const Inputs& in, std::vector<Element const*>& out) {
+    Ext::LoserTree<Element const*, Less> t(in.size());
+    std::vector<std::size_t> at(in.size(), 0);
+    for ( std::size_t i = 0; i < in.size(); ++i )
+      t.set(i, in[i].empty() ? nullptr : &in[i][at[i]++]);
+    t.build();
+    while ( t.any() ) {
+      out.push_back(t.top());
+      const std::size_t i = t.top_index();
+      t.replace_top(at[i] < in[i].size() ? &in[i][at[i]++] : nullptr);
+    } // while
+  }
+
+  bool failed = false;
+
+  void run(char const* name, void (*merge)(const Inputs&, std::vector<Element const*>&),
+           const Inputs& in, const std::vector<Element const*>& expect) {
+    std::vector<Element const*> out;
+    out.reserve(expect.size());
+    ncompares = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    merge(in, out);
+    auto t1 = std::chrono::steady_clock::now();
+    const double n = static_cast<double>(out.size());
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::printf("  k=%-5zu %-6s %9.1f ns/elem %8.2f cmp/elem\n", in.size(), name, ns / n, ncompares / n);
+    if ( !expect.empty() && out != expect ) {
+      std::printf("  ^^^ merge order differs\n");
+      failed = true;
+    }
+  }
+
+} // unnamed
+
+int main(int argc, char** argv) {
+  const std::size_t n = (argc > 1) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000000;
+  for ( std::size_t k : { 2, 16, 256, 2048 } ) {
+    const Inputs in = make_inputs(k, n);
+    std::vector<Element const*> expect;
+    const std::size_t maxScan = 20000000; // scan is k compares per element
+    if ( k * n <= maxScan * 16 )
+      scan(in, expect);
+    else
+      heap(in, expect);
+    for ( std::size_t i = 1; i < expect.size(); ++i ) { // sorted, stable over inputs
+      Less lt;
+      if ( lt(expect[i], expect[i-1]) ||
+           (!lt(expect[i-1], expect[i]) && expect[i]->input_ < expect[i-1]->input_) )
+        failed = true;
+    } // for
+    if ( k * n <= maxScan * 16 )
+      run("scan", scan, in, expect);
+    run("heap", heap, in, expect);
+    run("loser", loser, in, expect);
+  } // for
+
+  if ( failed ) {
+    std::fprintf(stderr, "LoserTreeBench: merge order mismatch\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,317 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 04:38:21 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+/*
+  Microbenchmark for Ext::OrderStatisticTree against the other ways the kth,
+    median and mad visitors can keep a sliding window:
+      marker : std::set<> with position markers walked to each new rank
+                (RollingKth, RollingKthAverage)
+      copy   : the window copied into a vector and nth_element()'d (what
+                MedianAbsoluteDeviation did before the tree)
+      tree   : select() and count_prefix(); MedianAbsoluteDeviation uses it, the
+                others stay with markers, which are cheaper for them
+  A sliding window of w scores, w = 10 to 100k, takes one new score and drops its
+    oldest for every row, then reports.  Scores are small integers, so ties are
+    common and ordered by address, as the visitors order equal values.
+    Reports ns per row.
+  Old and new must report the same value on every row, so this doubles as a
+    correctness test: exit status 1 on a mismatch.
+  usage: OrderStatisticBench [rows]  (fewer for the widest windows)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "utility/OrderStatisticTree.hpp"
+
+namespace {
+
+  typedef double MT;
+
+  struct Score {
+    MT v_;
+  };
+  typedef Score const* Ptr;
+
+  struct Comp { // value, then address
+    inline bool operator()(Ptr a, Ptr b) const {
+      if ( a->v_ != b->v_ )
+        return a->v_ < b->v_;
+      return a < b;
+    }
+  };
+
+  typedef Ext::OrderStatisticTree<Ptr, Comp> Tree;
+  typedef std::set<Ptr, Comp> Set;
+
+  //========
+  // Marker : a position in a std::set<> kept up to date across inserts and
+  //           erases
+  //========
+  struct Marker {
+    explicit Marker(Set& s) : s_(s), m_(s.end()), pos_(0) { }
+
+    // after s_.insert(p)
+    void add(Ptr p) {
+      if ( m_ == s_.end() ) {
+        m_ = s_.begin();
+        pos_ = 0;
+      } else if ( Comp()(p, *m_) ) {
+        ++pos_;
+      }
+    }
+
+    // before s_.erase(p); s_ has more than one element
+    void remove(Ptr p) {
+      if ( Comp()(p, *m_) ) {
+        --pos_;
+      } else if ( p == *m_ ) {
+        if ( m_ != s_.begin() ) {
+          --m_;
+          --pos_;
+        } else {
+          ++m_;
+        }
+      }
+    }
+
+    void moveTo(std::size_t newPos) {
+      while ( newPos > pos_ ) {
+        ++m_;
+        ++pos_;
+      } // while
+      while ( newPos < pos_ ) {
+        --m_;
+        --pos_;
+      } // while
+    }
+
+    Set& s_;
+    Set::iterator m_;
+    std::size_t pos_;
+  };
+
+  inline std::size_t kthPos(double kth, std::size_t n) {
+    std::size_t k = static_cast<std::size_t>(std::floor(kth * n + 0.5));
+    return (k > 0) ? k - 1 : 0;
+  }
+
+  const double Kth = 0.8;
+
+  //=============================
+  // the set/marker and copy side
+  //=============================
+  struct Old {
+    // only the markers the visitor for op kept; mad found its median with
+    //  nth_element() on the copy, like the rest of its work
+    explicit Old(int op) : kth_(s_), med_(s_) {
+      if ( op == 0 )
+        used_.push_back(&kth_);
+      else if ( op == 1 )
+        used_.push_back(&med_);
+    }
+
+    void insert(Ptr p) {
+      s_.insert(p);
+      for ( Marker* m : used_ )
+        m->add(p);
+    }
+
+    void erase(Ptr p) {
+      for ( Marker* m : used_ )
+        m->remove(p);
+      s_.erase(p);
+    }
+
+    MT kth() {
+      kth_.moveTo(kthPos(Kth, s_.size()));
+      return (*kth_.m_)->v_;
+    }
+
+    MT median() {
+      const std::size_t n = s_.size();
+      med_.moveTo((n - 1) / 2);
+      if ( n % 2 )
+        return (*med_.m_)->v_;
+      Set::iterator next = med_.m_;
+      return ((*med_.m_)->v_ + (*++next)->v_) / 2.0;
+    }
+
+    MT mad(const std::vector<Ptr>& window) {
+      v_.clear();
+      for ( Ptr p : window )
+        v_.push_back(p->v_);
+      const MT m = middle(v_);
+      for ( MT& d : v_ )
+        d = std::abs(d - m);
+      return middle(v_);
+    }
+
+  private:
+    static MT middle(std::vector<MT>& v) {
+      const std::size_t n = v.size();
+      std::nth_element(v.begin(), v.begin() + n / 2, v.end());
+      MT m = v[n / 2];
+      if ( n % 2 == 0 )
+        m = (m + *std::max_element(v.begin(), v.begin() + n / 2)) / 2.0;
+      return m;
+    }
+
+    Set s_;
+    Marker kth_, med_;
+    std::vector<Marker*> used_;
+    std::vector<MT> v_;
+  };
+
+  //==========
+  // tree side
+  //==========
+  struct New {
+    void insert(Ptr p) { t_.insert(p); }
+    void erase(Ptr p) { t_.erase(p); }
+
+    MT kth() const { return t_.select(kthPos(Kth, t_.size()))->v_; }
+
+    MT median() const {
+      const std::size_t n = t_.size();
+      if ( n % 2 )
+        return t_.select(n / 2)->v_;
+      return (t_.select(n / 2 - 1)->v_ + t_.select(n / 2)->v_) / 2.0;
+    }
+
+    // as MedianAbsoluteDeviation: the deviations below the median and those at or
+    //  above it are two ascending sequences; binary search across them
+    MT mad() const {
+      const std::size_t n = t_.size();
+      const MT m = median();
+      const std::size_t below = t_.count_prefix([m](Ptr p) { return p->v_ < m; });
+      if ( n % 2 )
+        return kthDeviation(n / 2, below, m);
+      return (kthDeviation(n / 2 - 1, below, m) + kthDeviation(n / 2, below, m)) / 2.0;
+    }
+
+  private:
+    MT lower(std::size_t below, MT m, std::size_t i) const { return std::abs(t_.select(below - 1 - i)->v_ - m); }
+    MT upper(std::size_t below, MT m, std::size_t i) const { return std::abs(t_.select(below + i)->v_ - m); }
+
+    MT kthDeviation(std::size_t k, std::size_t below, MT m) const {
+      const std::size_t nl = below, nu = t_.size() - below;
+      std::size_t lo = (k + 1 > nu) ? k + 1 - nu : 0, hi = std::min(k + 1, nl);
+      while ( true ) {
+        const std::size_t i = lo + (hi - lo) / 2, j = k + 1 - i;
+        if ( i > 0 && j < nu && lower(below, m, i - 1) > upper(below, m, j) )
+          hi = i - 1;
+        else if ( j > 0 && i < nl && upper(below, m, j - 1) > lower(below, m, i) )
+          lo = i + 1;
+        else if ( i == 0 )
+          return upper(below, m, j - 1);
+        else if ( j == 0 )
+          return lower(below, m, i - 1);
+        else
+          return std::max(lower(below, m, i - 1), upper(below, m, j - 1));
+      } // while
+    }
+
+    Tree t_;
+  };
+
+  enum Op { KTH, MEDIAN, MAD };
+  char const* const OpNames[] = { "kth", "median", "mad" };
+
+  inline MT mad(Old& o, const std::vector<Ptr>& window) { return o.mad(window); }
+  inline MT mad(New& n, const std::vector<Ptr>&) { return n.mad(); }
+
+  template <typename Side>
+  inline void report(Side& side, Op op, const std::vector<Ptr>& window, std::vector<MT>& out) {
+    switch ( op ) {
+      case KTH:    out.push_back(side.kth()); break;
+      case MEDIAN: out.push_back(side.median()); break;
+      case MAD:    out.push_back(mad(side, window)); break;
+    }
+  }
+
+  bool failed = false;
+
+  // slide a window of w over scores; results of every row go to out
+  template <typename Side>
+  double run(Side& side, Op op, const std::vector<Score>& scores, std::size_t w, std::vector<MT>& out) {
+    std::vector<Ptr> window; // the copy the old mad made; kept up to date for it
+    for ( std::size_t i = 0; i < w; ++i ) {
+      side.insert(&scores[i]);
+      window.push_back(&scores[i]);
+    } // for
+    out.clear();
+    report(side, op, window, out); // markers first walk from 0 to their ranks: not a row's cost
+    auto t0 = std::chrono::steady_clock::now();
+    for ( std::size_t i = w; i < scores.size(); ++i ) {
+      side.erase(&scores[i - w]);
+      side.insert(&scores[i]);
+      window[i % w] = &scores[i];
+      report(side, op, window, out);
+    } // for
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (scores.size() - w);
+  }
+
+
+} // unnamed
+
+int main(int argc, char** argv) {
+  const std::size_t rows = (argc > 1) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 20000;
+  std::mt19937_64 rng(7);
+  std::uniform_int_distribution<int> value(0, 999);
+
+  for ( std::size_t w : { 10, 100, 1000, 10000, 100000 } ) {
+    const std::size_t nrows = std::min(rows, std::max<std::size_t>(1000, 100000000 / w)); // copy is O(w) a row
+    std::vector<Score> scores(w + nrows);
+    for ( Score& s : scores )
+      s.v_ = value(rng);
+    for ( Op op : { KTH, MEDIAN, MAD } ) {
+      std::vector<MT> a, b;
+      Old o(op);
+      New n;
+      const double told = run(o, op, scores, w, a);
+      const double tnew = run(n, op, scores, w, b);
+      std::printf("  w=%-6zu %-6s %-6s %10.1f ns/row   tree %8.1f ns/row\n",
+                  w, OpNames[op], (op == MAD) ? "copy" : "marker", told, tnew);
+      if ( a != b ) {
+        std::printf("  ^^^ results differ\n");
+        failed = true;
+      }
+    } // for
+  } // for
+
+  if ( failed ) {
+    std::fprintf(stderr, "OrderStatisticBench: result mismatch\n");
+    return 1;
+  }
+  return 0;
+}
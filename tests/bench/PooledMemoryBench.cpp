@@ -0,0 +1,239 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 09:53:45 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+/*
+  Microbenchmark for Ext::PooledMemory and Ext::ConcurrentPooledMemory against
+    plain new/delete, over the construct/release patterns the sweeps produce:
+      fifo    : a window of live records; each new one releases the oldest (bedops, bedmap)
+      random  : a window of live records; each new one releases a random one
+      bulk    : construct everything, then release it all in order
+      handoff : a reader thread constructs batches that the calling thread releases
+                 (not for PooledMemory, which is single-threaded)
+  Every record carries a tag that is checked on release, so this doubles as a
+    quick correctness test: exit status 1 on a mismatch.
+  usage: PooledMemoryBench [operations]
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/ConcurrentPooledMemory.hpp"
+#include "utility/PooledMemory.hpp"
+
+namespace {
+
+  struct Record { // about the size of a Bed::B3Rest
+    explicit Record(std::uint64_t t) : tag_(t), start_(t), end_(t+1), chrom_(nullptr), rest_(nullptr) { }
+    std::uint64_t tag_;
+    std::uint64_t start_;
+    std::uint64_t end_;
+    char const* chrom_;
+    char const* rest_;
+  };
+
+  constexpr std::size_t PoolSz = 8*8*8;
+
+  struct Pool {
+    Ext::PooledMemory<Record, PoolSz> pool_;
+    inline Record* construct(std::uint64_t t) { return pool_.construct(t); }
+    inline void release(Record* r) { pool_.release(r); }
+    static char const* name() { return "PooledMemory"; }
+  };
+
+  struct SharedPool {
+    Ext::ConcurrentPooledMemory<Record, PoolSz> pool_;
+    inline Record* construct(std::uint64_t t) { return pool_.construct(t); }
+    inline void release(Record* r) { pool_.release(r); }
+    static char const* name() { return "Concurrent"; }
+  };
+
+  struct Heap {
+    inline Record* construct(std::uint64_t t) { return new Record(t); }
+    inline void release(Record* r) { delete r; }
+    static char const* name() { return "new/delete"; }
+  };
+
+  bool failed = false;
+
+  inline void check(Record* r, std::uint64_t t) {
+    if ( r->tag_ != t || r->end_ != t+1 )
+      failed = true;
+  }
+
+  // xorshift: the same sequence for every allocator
+  struct Rand {
+    Rand() : s_(88172645463325252ULL) { }
+    inline std::uint64_t operator()() { s_ ^= s_ << 13; s_ ^= s_ >> 7; s_ ^= s_ << 17; return s_; }
+    std::uint64_t s_;
+  };
+
+  template <typename Alloc>
+  void fifo(Alloc& a, std::size_t window, std::size_t ops) {
+    std::deque<Record*> live;
+    std::uint64_t next = 0, oldest = 0;
+    for ( std::size_t i = 0; i < ops; ++i ) {
+      live.push_back(a.construct(next++));
+      if ( live.size() > window ) {
+        check(live.front(), oldest++);
+        a.release(live.front());
+        live.pop_front();
+      }
+    } // for
+    while ( !live.empty() ) {
+      check(live.front(), oldest++);
+      a.release(live.front());
+      live.pop_front();
+    } // while
+  }
+
+  template <typename Alloc>
+  void random(Alloc& a, std::size_t window, std::size_t ops) {
+    std::vector<Record*> live;
+    Rand rnd;
+    live.reserve(window);
+    std::uint64_t next = 0;
+    for ( std::size_t i = 0; i < ops; ++i ) {
+      Record* r = a.construct(next++);
+      if ( live.size() < window ) {
+        live.push_back(r);
+        continue;
+      }
+      const std::size_t k = static_cast<std::size_t>(rnd() % window);
+      check(live[k], live[k]->start_);
+      a.release(live[k]);
+      live[k] = r;
+    } // for
+    for ( auto r : live ) {
+      check(r, r->start_);
+      a.release(r);
+    } // for
+  }
+
+  template <typename Alloc>
+  void bulk(Alloc& a, std::size_t, std::size_t ops) {
+    std::vector<Record*> live;
+    live.reserve(ops);
+    for ( std::size_t i = 0; i < ops; ++i )
+      live.push_back(a.construct(i));
+    for ( std::size_t i = 0; i < ops; ++i ) {
+      check(live[i], i);
+      a.release(live[i]);
+    } // for
+  }
+
+  template <typename Alloc>
+  void handoff(Alloc& a, std::size_t batch, std::size_t ops) {
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::vector<Record*>> q;
+    bool done = false;
+
+    std::thread reader([&]() {
+      std::vector<Record*> v;
+      for ( std::size_t i = 0; i < ops; ++i ) {
+        v.push_back(a.construct(i));
+        if ( v.size() == batch || i+1 == ops ) {
+          std::lock_guard<std::mutex> lock(m);
+          q.push_back(std::move(v));
+          v.clear();
+          cv.notify_one();
+        }
+      } // for
+      std::lock_guard<std::mutex> lock(m);
+      done = true;
+      cv.notify_one();
+    });
+
+    std::uint64_t next = 0;
+    while ( true ) {
+      std::vector<Record*> v;
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]() { return done || !q.empty(); });
+        if ( q.empty() )
+          break;
+        v = std::move(q.front());
+        q.pop_front();
+      }
+      for ( auto r : v ) {
+        check(r, next++);
+        a.release(r);
+      } // for
+    } // while
+    reader.join();
+    if ( next != ops )
+      failed = true;
+  }
+
+  template <typename Alloc, typename Pattern>
+  void run(char const* pattern, Pattern p, std::size_t window, std::size_t ops) {
+    double best = 0;
+    for ( int rep = 0; rep < 3; ++rep ) {
+      Alloc a;
+      const auto t0 = std::chrono::steady_clock::now();
+      p(a, window, ops);
+      const std::chrono::duration<double> d = std::chrono::steady_clock::now() - t0;
+      if ( rep == 0 || d.count() < best )
+        best = d.count();
+    } // for
+    std::printf("%-8s %-13s window %-8zu %8.2f ns/op\n", pattern, Alloc::name(), window, 1e9 * best / ops);
+  }
+
+} // unnamed namespace
+
+int main(int argc, char** argv) {
+  const std::size_t ops = (argc > 1) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000000;
+  const std::size_t windows[] = { 64, 4096, 262144 };
+  for ( auto w : windows ) {
+    run<Pool>("fifo", fifo<Pool>, w, ops);
+    run<SharedPool>("fifo", fifo<SharedPool>, w, ops);
+    run<Heap>("fifo", fifo<Heap>, w, ops);
+  } // for
+  for ( auto w : windows ) {
+    run<Pool>("random", random<Pool>, w, ops);
+    run<SharedPool>("random", random<SharedPool>, w, ops);
+    run<Heap>("random", random<Heap>, w, ops);
+  } // for
+  run<Pool>("bulk", bulk<Pool>, ops, ops);
+  run<SharedPool>("bulk", bulk<SharedPool>, ops, ops);
+  run<Heap>("bulk", bulk<Heap>, ops, ops);
+  for ( std::size_t batch : { 64, 4096 } ) {
+    run<SharedPool>("handoff", handoff<SharedPool>, batch, ops);
+    run<Heap>("handoff", handoff<Heap>, batch, ops);
+  } // for
+
+  if ( failed ) {
+    std::fprintf(stderr, "PooledMemoryBench: record mismatch\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 03:31:01 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+/*
+  Microbenchmark for the sliding window of sweep(): Ext::RingBuffer, or the older
+    std::deque when built with -DSWEEP_DEQUE_WINDOW, the same switch that
+    WindowSweepImpl.cpp uses.  Build it both ways to compare.
+  Each reference position drops the window's expired front, pushes the map
+    elements that now start before it and counts what is left, as the two-input
+    sweep() does, for windows from sparse (about 1 element wide) to dense
+    (5000 wide).  Reports ns per reference.
+  Overlap counts are checked against two-pointer counts over the sorted
+    elements, so this doubles as a correctness test: exit status 1 on a mismatch.
+  usage: RingBufferBench [references]
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "utility/RingBuffer.hpp"
+
+namespace {
+
+#ifdef SWEEP_DEQUE_WINDOW
+  template <typename T>
+  using Window = std::deque<T>;
+  char const* WindowName = "deque";
+#else
+  template <typename T>
+  using Window = Ext::RingBuffer<T>;
+  char const* WindowName = "ring";
+#endif
+
+  struct Element {
+    std::uint64_t start_;
+    std::uint64_t end_;
+  };
+
+  // map elements of length len every step bases; references are 1 base wide at every base
+  std::vector<Element> make_map(std::size_t n, std::uint64_t step, std::uint64_t len) {
+    std::vector<Element> m;
+    m.reserve(n / step + 1);
+    for ( std::uint64_t s = 0; s < n; s += step )
+      m.push_back(Element{s, s + len});
+    return m;
+  }
+
+  std::uint64_t sweep(const std::vector<Element>& map, std::size_t nrefs) {
+    Window<Element const*> win;
+    std::size_t next = 0;
+    std::uint64_t total = 0;
+    for ( std::uint64_t r = 0; r < nrefs; ++r ) {
+      std::size_t sz = 0;
+      while ( sz < win.size() && win[sz]->end_ <= r ) // entirely before this reference
+        ++sz;
+      while ( sz-- > 0 )
+        win.pop_front();
+      while ( next < map.size() && map[next].start_ < r + 1 )
+        win.push_back(&map[next++]);
+      total += win.size(); // every element has the same length: all of win overlaps r
+    } // for
+    return total;
+  }
+
+  // every element has the same length, so ends are sorted along with starts
+  std::uint64_t expected(const std::vector<Element>& map, std::size_t nrefs) {
+    std::size_t lo = 0, hi = 0;
+    std::uint64_t total = 0;
+    for ( std::uint64_t r = 0; r < nrefs; ++r ) {
+      while ( lo < map.size() && map[lo].end_ <= r )
+        ++lo;
+      while ( hi < map.size() && map[hi].start_ < r + 1 )
+        ++hi;
+      total += hi - lo;
+    } // for
+    return total;
+  }
+
+} // unnamed
+
+int main(int argc, char** argv) {
+  const std::size_t n = (argc > 1) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000000;
+  struct Pattern { char const* name_; std::uint64_t step_; std::uint64_t len_; };
+  const Pattern patterns[] = { { "sparse", 50, 1 }, { "width 8", 1, 8 }, { "width 200", 1, 200 }, { "width 5000", 1, 5000 } };
+
+  bool failed = false;
+  for ( const Pattern& p : patterns ) {
+    const std::vector<Element> map = make_map(n, p.step_, p.len_);
+    auto t0 = std::chrono::steady_clock::now();
+    const std::uint64_t got = sweep(map, n);
+    auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::printf("  %-6s %-10s %9.2f ns/ref %9.2f overlaps/ref\n", WindowName, p.name_, ns / n, static_cast<double>(got) / n);
+    if ( got != expected(map, n) ) {
+      std::printf("  ^^^ overlap count differs\n");
+      failed = true;
+    }
+  } // for
+
+  if ( failed ) {
+    std::fprintf(stderr, "RingBufferBench: overlap count mismatch\n");
+    return 1;
+  }
+  return 0;
+}
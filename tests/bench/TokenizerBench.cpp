@@ -0,0 +1,251 @@
+/*
+  Author: agent
+  Date:   Sat Oct 17 05:55:47 UTC 2026
+*/
+//
+//    BEDOPS
+//    Copyright (C) 2011-2025 Shane Neph, Scott Kuehn and Alex Reynolds
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License along
+//    with this program; if not, write to the Free Software Foundation, Inc.,
+//    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+/*
+  Microbenchmark for Bed::Tokenize against the scanf() calls the Bed types used before:
+      scanf : sscanf() of a std::string, or fscanf() + fgetc() of a FILE*, with the
+               formats Bed3 and Bed5 types with a rest had (inFormatter())
+      token : readline(std::string) and readline(FILE*) of B3Rest and B5Rest
+  Rows are BED6 with one more column of 0 to 210 bytes, so rows come in every length
+    from about 30 to 250 and few are a multiple of 64: the end of each row's rest is
+    found in each of eol()'s block, 16 and 8 byte steps and in single bytes.  Reports
+    rows per second.
+  Both sides must parse the same chromosome, coordinates, id, measurement and rest
+    from every row, so this doubles as a correctness test: exit status 1 on a
+    mismatch.  Each row is also parsed from buffers of exactly its size, as from a
+    file mapping and as a bare char const*; built with -fsanitize=address, that
+    checks that no read leaves a row's buffer.
+  usage: TokenizerBench [rows]
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "data/bed/BedTypes.hpp"
+
+namespace {
+
+  const char* const Format3 = "%s\t%" SCNu64 "\t%" SCNu64 "%[^\n]s\n";
+  const char* const Format5 = "%s\t%" SCNu64 "\t%" SCNu64 "\t%s\t%lf%[^\n]s\n";
+
+  // what one row parsed to; rest_ is everything past the 3rd column (Bed3) or 5th (Bed5)
+  struct Row {
+    std::string chrom_;
+    std::uint64_t start_;
+    std::uint64_t end_;
+    std::string id_;
+    double measurement_;
+    std::string rest_;
+
+    bool operator==(const Row& r) const {
+      return chrom_ == r.chrom_ && start_ == r.start_ && end_ == r.end_ &&
+             id_ == r.id_ && measurement_ == r.measurement_ && rest_ == r.rest_;
+    }
+  };
+
+  //============
+  // scanf side
+  //============
+  struct Scanf {
+    char chrom_[Bed::MAXCHROMSIZE+1];
+    char id_[Bed::MAXIDSIZE+1];
+    char rest_[Bed::MAXRESTSIZE+1];
+    std::uint64_t start_, end_;
+    double measurement_;
+
+    void clear() { chrom_[0] = id_[0] = rest_[0] = '\0'; start_ = end_ = 0; measurement_ = 0; }
+
+    Row row3() const { return Row{chrom_, start_, end_, "", 0, rest_}; }
+    Row row5() const { return Row{chrom_, start_, end_, id_, measurement_, rest_}; }
+  };
+
+  template <bool IsBed5>
+  inline void scan(Scanf& s, const std::string& line) {
+    s.clear();
+    if ( IsBed5 )
+      std::sscanf(line.c_str(), Format5, s.chrom_, &s.start_, &s.end_, s.id_, &s.measurement_, s.rest_);
+    else
+      std::sscanf(line.c_str(), Format3, s.chrom_, &s.start_, &s.end_, s.rest_);
+  }
+
+  template <bool IsBed5>
+  inline bool scan(Scanf& s, FILE* f) {
+    s.clear();
+    int n;
+    if ( IsBed5 )
+      n = std::fscanf(f, Format5, s.chrom_, &s.start_, &s.end_, s.id_, &s.measurement_, s.rest_);
+    else
+      n = std::fscanf(f, Format3, s.chrom_, &s.start_, &s.end_, s.rest_);
+    std::fgetc(f);
+    return n != EOF;
+  }
+
+  inline Row get(const Scanf& s, std::false_type) { return s.row3(); }
+  inline Row get(const Scanf& s, std::true_type) { return s.row5(); }
+
+  //===============
+  // tokenizer side
+  //===============
+  inline Row get(const Bed::B3Rest& b) {
+    return Row{b.chrom(), b.start(), b.end(), "", 0, b.full_rest()};
+  }
+
+  // full_rest() is "\t<id>\t<measurement>" then the rest of the row
+  inline Row get(const Bed::B5Rest& b) {
+    char const* r = b.full_rest();
+    return Row{b.chrom(), b.start(), b.end(), b.id(), b.measurement(),
+               (b.rest_offset() < 0) ? "" : r + b.rest_offset()};
+  }
+
+  //=====
+  // rows
+  //=====
+  std::vector<std::string> make_rows(std::size_t n) {
+    std::vector<std::string> rows;
+    rows.reserve(n);
+    std::uint64_t start = 0;
+    for ( std::size_t i = 0; i < n; ++i ) {
+      start += (i * 7919) % 500;
+      char head[128];
+      std::snprintf(head, sizeof(head), "chr%zu\t%" PRIu64 "\t%" PRIu64 "\tid-%zu\t%.3f\t%c",
+                    1 + (i * 31) % 22, start, start + 1 + (i * 104729) % 5000, i,
+                    static_cast<double>((i * 2654435761u) % 100000) / 7.0, (i % 2) ? '+' : '-');
+      std::string r(head);
+      const std::size_t extra = (i * 37) % 211;
+      if ( extra ) {
+        r += '\t';
+        for ( std::size_t j = 0; j < extra; ++j )
+          r += static_cast<char>('a' + (i + j) % 26);
+      }
+      if ( r.size() % 64 == 0 )
+        r += 'z';
+      rows.push_back(r);
+    } // for
+    return rows;
+  }
+
+  bool failed = false;
+
+  double rate(std::chrono::steady_clock::time_point t0, std::size_t n) {
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return n / s;
+  }
+
+  // timed passes only parse, keeping a checksum; a second, untimed pass compares
+  template <typename BedType, bool IsBed5>
+  void run(char const* name, const std::vector<std::string>& rows, FILE* f) {
+    typedef std::integral_constant<bool, IsBed5> Tag;
+    Scanf s;
+    BedType bt;
+    std::uint64_t sums[4] = { 0, 0, 0, 0 };
+
+    auto t0 = std::chrono::steady_clock::now();
+    for ( const std::string& r : rows ) {
+      scan<IsBed5>(s, r);
+      sums[0] += s.end_;
+    } // for
+    const double sstr = rate(t0, rows.size());
+
+    t0 = std::chrono::steady_clock::now();
+    for ( const std::string& r : rows ) {
+      bt.readline(r);
+      sums[1] += bt.end();
+    } // for
+    const double tstr = rate(t0, rows.size());
+
+    std::rewind(f);
+    t0 = std::chrono::steady_clock::now();
+    while ( scan<IsBed5>(s, f) )
+      sums[2] += s.end_;
+    const double sfile = rate(t0, rows.size());
+
+    std::rewind(f);
+    t0 = std::chrono::steady_clock::now();
+    while ( bt.readline(f) != EOF )
+      sums[3] += bt.end();
+    const double tfile = rate(t0, rows.size());
+
+    std::printf("  %-6s string: scanf %6.2f  token %6.2f Mrows/s   FILE*: scanf %6.2f  token %6.2f Mrows/s\n",
+                name, sstr / 1e6, tstr / 1e6, sfile / 1e6, tfile / 1e6);
+
+    // rows are also copied to buffers of exactly their size: ending in a '\n' and no
+    //  '\0', as in a file mapping, and ending in a '\0' for a bare char const*
+    bool same = (sums[0] == sums[1] && sums[2] == sums[3]);
+    std::vector<Row> a, b;
+    for ( const std::string& r : rows ) {
+      scan<IsBed5>(s, r);
+      const Row expect = get(s, Tag());
+      bt.readline(r);
+      same = same && (get(bt) == expect);
+      std::vector<char> mapped(r.begin(), r.end());
+      mapped.push_back('\n');
+      bt.readline(mapped.data(), nullptr, mapped.data() + mapped.size());
+      same = same && (get(bt) == expect);
+      std::vector<char> bare(r.c_str(), r.c_str() + r.size() + 1);
+      bt.readline(bare.data());
+      same = same && (get(bt) == expect);
+    } // for
+    std::rewind(f);
+    while ( scan<IsBed5>(s, f) )
+      a.push_back(get(s, Tag()));
+    std::rewind(f);
+    while ( bt.readline(f) != EOF )
+      b.push_back(get(bt));
+    if ( !same || a != b || a.size() != rows.size() ) {
+      std::printf("  ^^^ %s rows differ\n", name);
+      failed = true;
+    }
+  }
+
+} // unnamed
+
+int main(int argc, char** argv) {
+  const std::size_t n = (argc > 1) ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+  const std::vector<std::string> rows = make_rows(n);
+  FILE* f = std::tmpfile();
+  if ( !f ) {
+    std::fprintf(stderr, "TokenizerBench: no temporary file\n");
+    return 1;
+  }
+  for ( const std::string& r : rows ) {
+    std::fputs(r.c_str(), f);
+    std::fputc('\n', f);
+  } // for
+
+  run<Bed::B3Rest, false>("Bed3", rows, f);
+  run<Bed::B5Rest, true>("Bed5", rows, f);
+  std::fclose(f);
+
+  if ( failed ) {
+    std::fprintf(stderr, "TokenizerBench: parse mismatch\n");
+    return 1;
+  }
+  return 0;
+}